@@ -1,12 +1,9 @@
 #include <cstdlib>
 #include <iostream>
 #include <cmath>
-#include <tuple>
 #include <random>
 #include <mpl/mpl.hpp>
 
-using double_2 = std::tuple<double, double>;
-
 
 template<std::size_t dim, typename T, typename A>
 mpl::irequest_pool update_overlap(const mpl::cartesian_communicator &communicator,
@@ -147,15 +144,12 @@ int main() {
         sum_u += std::abs(u_d_2(i, j));
       }
     // determine global sum of delta_u and sum_u and distribute to all processors
-    double_2 delta_sum_u{delta_u, sum_u};  // pack into pair
-    comm_c.allreduce(
-        [](double_2 a, double_2 b) {
-          // reduction adds component-by-component
-          return double_2{std::get<0>(a) + std::get<0>(b), std::get<1>(a) + std::get<1>(b)};
-        },
-        delta_sum_u);
-    std::tie(delta_u, sum_u) = delta_sum_u;  // unpack from pair
-    converged = delta_u / sum_u < 1e-3;      // check for convergence
+    // by a single collective communication operation
+    mpl::allreduce_batch sums;
+    sums.add(mpl::plus<double>(), delta_u, delta_u);
+    sums.add(mpl::plus<double>(), sum_u, sum_u);
+    comm_c.allreduce(sums);
+    converged = delta_u / sum_u < 1e-3;  // check for convergence
     u_d_2.swap(u_d_1);
   }
   // gather data and print result
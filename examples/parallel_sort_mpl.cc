@@ -15,7 +15,8 @@ double get_random() {
 }
 
 
-void fill_random(std::vector<double> &v) {
+template<typename A>
+void fill_random(std::vector<double, A> &v) {
   std::generate(std::begin(v), std::end(v), get_random);
 }
 
@@ -34,10 +35,12 @@ void fill_random(std::vector<double> &v) {
 // Note that the amount of data at each process changes during the algorithm.
 // In worst case, a single process may hold finally all data.
 //
+// The data is held in a vector of the type that mpl::csr_vector uses for its elements, such
+// that the redistributed data can be taken over without copying.
+//
 template<typename T>
-void parallel_sort(std::vector<T> &v) {
+void parallel_sort(typename mpl::csr_vector<T>::values_type &v) {
   auto &comm_world{mpl::environment::comm_world()};
-  const int rank{comm_world.rank()};
   const int size{comm_world.size()};
   std::vector<T> local_pivots, pivots(size * (size - 1));
   std::sample(begin(v), end(v), std::back_inserter(local_pivots), size - 1, mt);
@@ -48,29 +51,18 @@ void parallel_sort(std::vector<T> &v) {
   for (std::size_t i{1}; i < static_cast<std::size_t>(size); ++i)
     local_pivots.push_back(pivots[i * (size - 1)]);
   swap(local_pivots, pivots);
-  std::vector<typename std::vector<T>::iterator> pivot_pos;
+  std::vector<typename mpl::csr_vector<T>::values_type::iterator> pivot_pos;
   pivot_pos.push_back(begin(v));
   for (T p : pivots)
     pivot_pos.push_back(std::partition(pivot_pos.back(), end(v), [p](T x) { return x < p; }));
   pivot_pos.push_back(end(v));
-  std::vector<int> local_block_sizes, block_sizes(size * size);
-  for (std::size_t i{0}; i < pivot_pos.size() - 1; ++i)
-    local_block_sizes.push_back(
-        static_cast<int>(std::distance(pivot_pos[i], pivot_pos[i + 1])));
-  comm_world.allgather(local_block_sizes.data(), mpl::vector_layout<int>(size),
-                       block_sizes.data(), mpl::vector_layout<int>(size));
-  mpl::layouts<T> send_layouts, recv_layouts;
-  int send_pos{0}, recv_pos{0};
-  for (int i{0}; i < size; ++i) {
-    send_layouts.push_back(mpl::indexed_layout<T>({{block_sizes[rank * size + i], send_pos}}));
-    send_pos += block_sizes[rank * size + i];
-    recv_layouts.push_back(mpl::indexed_layout<T>({{block_sizes[rank + size * i], recv_pos}}));
-    recv_pos += block_sizes[rank + size * i];
-  }
-  std::vector<T> v_2(recv_pos);
-  comm_world.alltoallv(v.data(), send_layouts, v_2.data(), recv_layouts);
-  std::sort(begin(v_2), end(v_2));
-  swap(v, v_2);
+  std::vector<std::size_t> send_offsets;
+  for (const auto &pos : pivot_pos)
+    send_offsets.push_back(static_cast<std::size_t>(std::distance(begin(v), pos)));
+  mpl::csr_vector<T> v_2;
+  comm_world.alltoallv(v, send_offsets, v_2);
+  v = v_2.release_values();
+  std::sort(begin(v), end(v));
 }
 
 
@@ -79,8 +71,8 @@ int main() {
   const int size{comm_world.size()};
 
   const std::size_t N{100000000 / static_cast<std::size_t>(size)};
-  std::vector<double> v(N);
+  mpl::csr_vector<double>::values_type v(N);
   fill_random(v);
-  parallel_sort(v);
+  parallel_sort<double>(v);
   return EXIT_SUCCESS;
 }
@@ -9,7 +9,7 @@
 
 
 // data type to store the data and the position of the global minimum
-using pair_t = std::pair<double, int>;
+using pair_t = mpl::value_index<double>;
 
 
 int main() {
@@ -21,32 +21,33 @@ int main() {
   // populate vector with random data
   std::vector<pair_t> v(n);
   std::generate(v.begin(), v.end(), [&comm_world, &g, &uniform]() {
-    return std::make_pair(uniform(g), comm_world.rank());
+    return pair_t{uniform(g), comm_world.rank()};
   });
-  // calculate minimum and its location and send result to rank root
+  // calculate minimum and its location and send result to rank root, mpl::min_loc is mapped
+  // to the predefined reduction operation MPI_MINLOC on the data type MPI_DOUBLE_INT
   const int root{0};
   mpl::contiguous_layout<pair_t> layout(n);
   if (comm_world.rank() == root) {
     std::vector<pair_t> result(n);
     // calculate minimum
-    comm_world.reduce(mpl::min<pair_t>(), root, v.data(), result.data(), layout);
+    comm_world.reduce(mpl::min_loc<double>(), root, v.data(), result.data(), layout);
     // display data from all ranks
     std::cout << "arguments:\n";
     for (int r{0}; r < comm_world.size(); ++r) {
       if (r > 0)
         comm_world.recv(v.data(), layout, r);
       for (auto i : v)
-        std::cout << std::fixed << std::setprecision(5) << i.first << ' ' << i.second << '\t';
+        std::cout << std::fixed << std::setprecision(5) << i.value << ' ' << i.index << '\t';
       std::cout << '\n';
     }
     // display results of global reduction
     std::cout << "\nresults:\n";
     for (const pair_t &i : result)
-      std::cout << std::fixed << std::setprecision(5) << i.first << ' ' << i.second << '\t';
+      std::cout << std::fixed << std::setprecision(5) << i.value << ' ' << i.index << '\t';
     std::cout << '\n';
   } else {
     // calculate minimum and its location and send result to rank 0
-    comm_world.reduce(mpl::min<pair_t>(), root, v.data(), layout);
+    comm_world.reduce(mpl::min_loc<double>(), root, v.data(), layout);
     // send data to rank 0 for display
     comm_world.send(v.data(), layout, root);
   }
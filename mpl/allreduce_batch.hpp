@@ -0,0 +1,262 @@
+#if !(defined MPL_ALLREDUCE_BATCH_HPP)
+
+#define MPL_ALLREDUCE_BATCH_HPP
+
+#include <mpi.h>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <mpl/layout.hpp>
+#include <mpl/operator.hpp>
+#include <mpl/request.hpp>
+
+
+namespace mpl {
+
+  namespace impl {
+    class base_communicator;
+  }
+
+  /// Collection of several independent all-reduce operations on single values, which are
+  /// carried out by a single collective communication operation.  Each reduction operation
+  /// may have its own data type and its own reduction operation.  Fusing reduction operations
+  /// reduces the number of network round trips in latency-bound algorithms.
+  ///
+  /// Reduction operations are added to a batch via \ref add and are performed by
+  /// <tt>communicator::allreduce</tt> or <tt>communicator::iallreduce</tt>.  All processes
+  /// must add the same sequence of reduction operations to their batches.  If all reduction
+  /// operations of a batch are equivalent to the same predefined MPI reduction operation on
+  /// the same data type, the batch is reduced by this predefined operation.
+  /// \note A batch must neither be modified nor destroyed while a non-blocking all-reduce
+  /// operation on the batch is pending.
+  class allreduce_batch {
+    class base_entry {
+    public:
+      const std::size_t offset;
+      const MPI_Datatype datatype;
+      const MPI_Op builtin_op;
+
+      base_entry(std::size_t offset_, MPI_Datatype datatype_, MPI_Op builtin_op_)
+          : offset{offset_}, datatype{datatype_}, builtin_op{builtin_op_} {
+      }
+
+      base_entry(const base_entry &) = delete;
+
+      void operator=(const base_entry &) = delete;
+
+      virtual ~base_entry() = default;
+
+      virtual void pack(std::byte *buffer) const = 0;
+
+      virtual void reduce(const std::byte *in, std::byte *in_out) = 0;
+
+      virtual void unpack(const std::byte *buffer) const = 0;
+    };
+
+    template<typename T, typename F>
+    class entry final : public base_entry {
+      F f_;
+      T send_data_;
+      T &recv_data_;
+
+      static MPI_Op get_builtin_op() {
+        if constexpr (detail::builtin_op<T, F>::is_available)
+          return detail::builtin_op<T, F>::get();
+        else
+          return MPI_OP_NULL;
+      }
+
+    public:
+      entry(std::size_t offset, F f, const T &send_data, T &recv_data)
+          : base_entry{offset, detail::datatype_traits<T>::get_datatype(), get_builtin_op()},
+            f_{std::move(f)},
+            send_data_{send_data},
+            recv_data_{recv_data} {
+      }
+
+      void pack(std::byte *buffer) const override {
+        ::new (buffer + offset) T(send_data_);
+      }
+
+      void reduce(const std::byte *in, std::byte *in_out) override {
+        auto *x{reinterpret_cast<const T *>(in + offset)};
+        auto *y{reinterpret_cast<T *>(in_out + offset)};
+        *y = f_(*x, *y);
+      }
+
+      void unpack(const std::byte *buffer) const override {
+        recv_data_ = *reinterpret_cast<const T *>(buffer + offset);
+      }
+    };
+
+    // reduction operation on the whole record of packed values, applies the reduction
+    // operation of each entry to its value
+    class fused_reduction {
+      allreduce_batch *batch_;
+
+    public:
+      explicit fused_reduction(allreduce_batch &batch) : batch_{&batch} {
+      }
+
+      void operator()(const std::byte *in, std::byte *in_out, int n) {
+        for (int i{0}; i < n; ++i, in += batch_->size_, in_out += batch_->size_)
+          for (auto &e : batch_->entries_)
+            e->reduce(in, in_out);
+      }
+    };
+
+    // non-blocking all-reduce operation on a batch, scatters the results when completed
+    class iallreduce_task final : public impl::progress_task {
+      allreduce_batch &batch_;
+      std::optional<detail::reduction_op<std::byte, fused_reduction>> op_;
+      MPI_Request req_{MPI_REQUEST_NULL};
+
+    public:
+      iallreduce_task(allreduce_batch &batch, MPI_Comm comm) : batch_{batch} {
+        batch_.pack();
+        if (const MPI_Op builtin_op{batch_.builtin_op()}; builtin_op != MPI_OP_NULL)
+          MPI_Iallreduce(batch_.send_buffer_.data(), batch_.recv_buffer_.data(),
+                         static_cast<int>(batch_.entries_.size()),
+                         batch_.entries_.front()->datatype, builtin_op, comm, &req_);
+        else if (not batch_.entries_.empty()) {
+          const detail::datatype_handle type{batch_.record_datatype()};
+          op_.emplace(fused_reduction{batch_});
+          MPI_Iallreduce(batch_.send_buffer_.data(), batch_.recv_buffer_.data(), 1, type.get(),
+                         op_->mpi_op, comm, &req_);
+        }
+      }
+
+      bool progress() override {
+        int flag{1};
+        MPI_Status s{};
+        if (req_ != MPI_REQUEST_NULL)
+          MPI_Test(&req_, &flag, &s);
+        if (flag == 0)
+          return false;
+        batch_.unpack();
+        complete(s);
+        return true;
+      }
+    };
+
+    std::vector<std::unique_ptr<base_entry>> entries_;
+    std::size_t size_{0};
+    std::vector<std::byte> send_buffer_;
+    std::vector<std::byte> recv_buffer_;
+
+    void pack() {
+      send_buffer_.resize(size_);
+      recv_buffer_.resize(size_);
+      for (const auto &e : entries_)
+        e->pack(send_buffer_.data());
+    }
+
+    void unpack() const {
+      for (const auto &e : entries_)
+        e->unpack(recv_buffer_.data());
+    }
+
+    // predefined reduction operation that is equivalent to all reduction operations of the
+    // batch, MPI_OP_NULL if there is none
+    [[nodiscard]] MPI_Op builtin_op() const {
+      if (entries_.empty())
+        return MPI_OP_NULL;
+      const base_entry &first{*entries_.front()};
+      for (const auto &e : entries_)
+        if (e->builtin_op == MPI_OP_NULL or e->builtin_op != first.builtin_op or
+            e->datatype != first.datatype)
+          return MPI_OP_NULL;
+      return first.builtin_op;
+    }
+
+    [[nodiscard]] MPI_Datatype record_datatype() const {
+      const int count{static_cast<int>(entries_.size())};
+      std::vector<int> blocklengths(count, 1);
+      std::vector<MPI_Aint> displacements;
+      std::vector<MPI_Datatype> datatypes;
+      displacements.reserve(count);
+      datatypes.reserve(count);
+      for (const auto &e : entries_) {
+        displacements.push_back(static_cast<MPI_Aint>(e->offset));
+        datatypes.push_back(e->datatype);
+      }
+      MPI_Datatype record_type;
+      MPI_Type_create_struct(count, blocklengths.data(), displacements.data(), datatypes.data(),
+                             &record_type);
+      MPI_Datatype resized_type;
+      MPI_Type_create_resized(record_type, 0, static_cast<MPI_Aint>(size_), &resized_type);
+      MPI_Type_free(&record_type);
+      return resized_type;
+    }
+
+    void allreduce(MPI_Comm comm) {
+      pack();
+      if (const MPI_Op op{builtin_op()}; op != MPI_OP_NULL)
+        MPI_Allreduce(send_buffer_.data(), recv_buffer_.data(),
+                      static_cast<int>(entries_.size()), entries_.front()->datatype, op, comm);
+      else if (not entries_.empty()) {
+        const detail::datatype_handle type{record_datatype()};
+        MPI_Allreduce(send_buffer_.data(), recv_buffer_.data(), 1, type.get(),
+                      detail::get_op<std::byte, fused_reduction>(fused_reduction{*this}).mpi_op,
+                      comm);
+      }
+      unpack();
+    }
+
+  public:
+    /// Creates an empty batch.
+    allreduce_batch() = default;
+
+    allreduce_batch(const allreduce_batch &) = delete;
+
+    void operator=(const allreduce_batch &) = delete;
+
+    /// Adds an all-reduce operation on a single value to the batch.
+    /// \tparam F type representing the reduction operation, reduction operation is performed
+    /// on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+    /// section
+    /// \param f reduction operation
+    /// \param send_data input data for the reduction operation, is copied into the batch
+    /// \param recv_data will hold the result of the reduction operation when the batch has
+    /// been reduced, must remain valid until then
+    template<typename T, typename F>
+    void add(F f, const T &send_data, T &recv_data) {
+      static_assert(detail::is_binary_functor<T, F>::value,
+                    "reduction operator must be a binary function");
+      static_assert(std::is_trivially_destructible_v<T>,
+                    "data type must be trivially destructible");
+      static_assert(alignof(T) <= alignof(std::max_align_t), "data type is over-aligned");
+      const std::size_t offset{(size_ + alignof(T) - 1) / alignof(T) * alignof(T)};
+      entries_.push_back(
+          std::make_unique<entry<T, F>>(offset, std::move(f), send_data, recv_data));
+      size_ = offset + sizeof(T);
+    }
+
+    /// \return number of reduction operations in the batch
+    [[nodiscard]] std::size_t size() const {
+      return entries_.size();
+    }
+
+    /// \return true if the batch contains no reduction operations
+    [[nodiscard]] bool empty() const {
+      return entries_.empty();
+    }
+
+    /// Removes all reduction operations from the batch.
+    void clear() {
+      entries_.clear();
+      size_ = 0;
+    }
+
+    friend class impl::base_communicator;
+  };
+
+}  // namespace mpl
+
+#endif
@@ -0,0 +1,640 @@
+#if !(defined MPL_COLLECTIVE_ALGORITHMS_HPP)
+
+#define MPL_COLLECTIVE_ALGORITHMS_HPP
+
+#include <mpi.h>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <mpl/datatype.hpp>
+#include <mpl/operator.hpp>
+
+
+namespace mpl::detail {
+
+  // Implementations of collective operations by point-to-point communication.  All processes
+  // of the communicator must call the same algorithm with matching arguments.  The
+  // communicator must not be used for other point-to-point communication with the tag
+  // collective_algorithm_tag concurrently.  The tag differs from the tags of sparse data
+  // exchanges, which share the internal duplicate of a communicator with these algorithms.
+
+  inline constexpr int collective_algorithm_tag{2};
+
+  template<typename T>
+  T *displaced(T *data, MPI_Aint displacement) {
+    return reinterpret_cast<T *>(reinterpret_cast<char *>(data) + displacement);
+  }
+
+  template<typename T>
+  const T *displaced(const T *data, MPI_Aint displacement) {
+    return reinterpret_cast<const T *>(reinterpret_cast<const char *>(data) + displacement);
+  }
+
+  // combines the partial result of another process with the partial result of this process,
+  // the operand of the lower ranking process is the left operand of the reduction operation,
+  // the result is stored in own, other is overwritten
+  template<typename T, typename F>
+  void reduce_partial_results(F &f, T *other, T *own, int n, bool other_is_left) {
+    if (other_is_left)
+      reduction_kernel(f, static_cast<const T *>(other), own, n);
+    else {
+      reduction_kernel(f, static_cast<const T *>(own), other, n);
+      std::copy(other, other + n, own);
+    }
+  }
+
+  // processes are folded onto the largest power of two not greater than the number of
+  // processes, the first 2 * rest processes form pairs, the odd process of each pair takes
+  // part in the power-of-two algorithm on behalf of the pair
+  class power_of_two_folding {
+    int rank_;
+    int rest_;
+    int size_;
+
+  public:
+    power_of_two_folding(int rank, int size) : rank_{rank}, rest_{0}, size_{1} {
+      while (2 * size_ <= size)
+        size_ *= 2;
+      rest_ = size - size_;
+    }
+
+    // size of the folded set of processes
+    [[nodiscard]] int size() const {
+      return size_;
+    }
+
+    // rank within the folded set of processes, -1 if not taking part
+    [[nodiscard]] int folded_rank() const {
+      if (rank_ < 2 * rest_)
+        return rank_ % 2 == 0 ? -1 : rank_ / 2;
+      return rank_ - rest_;
+    }
+
+    // rank of the process with the given rank within the folded set of processes
+    [[nodiscard]] int unfolded_rank(int folded_rank) const {
+      return folded_rank < rest_ ? 2 * folded_rank + 1 : folded_rank + rest_;
+    }
+
+    // true if the calling process is part of a pair
+    [[nodiscard]] bool is_paired() const {
+      return rank_ < 2 * rest_;
+    }
+
+    // rank of the other process of the pair
+    [[nodiscard]] int pair_rank() const {
+      return rank_ % 2 == 0 ? rank_ + 1 : rank_ - 1;
+    }
+  };
+
+  // reduces the data of each pair at its odd process
+  template<typename T, typename F>
+  void fold_reduce(F &f, const power_of_two_folding &folding, int rank, T *data, T *buffer,
+                   int n, MPI_Comm comm) {
+    if (not folding.is_paired())
+      return;
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    if (rank % 2 == 0)
+      MPI_Send(data, n, datatype, folding.pair_rank(), collective_algorithm_tag, comm);
+    else {
+      MPI_Recv(buffer, n, datatype, folding.pair_rank(), collective_algorithm_tag, comm,
+               MPI_STATUS_IGNORE);
+      reduction_kernel(f, static_cast<const T *>(buffer), data, n);
+    }
+  }
+
+  // sends the result of each pair from its odd process to its even process
+  template<typename T>
+  void unfold_result(const power_of_two_folding &folding, int rank, T *data, int n,
+                     MPI_Comm comm) {
+    if (not folding.is_paired())
+      return;
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    if (rank % 2 == 0)
+      MPI_Recv(data, n, datatype, folding.pair_rank(), collective_algorithm_tag, comm,
+               MPI_STATUS_IGNORE);
+    else
+      MPI_Send(data, n, datatype, folding.pair_rank(), collective_algorithm_tag, comm);
+  }
+
+  // all-reduce by recursive doubling, latency-optimal, reduction operation need not be
+  // commutative
+  template<typename T, typename F>
+  void allreduce_recursive_doubling(F f, const T *send_data, T *recv_data, int n,
+                                    MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    if (send_data != recv_data)
+      std::copy(send_data, send_data + n, recv_data);
+    std::vector<T> buffer(n);
+    const power_of_two_folding folding(rank, size);
+    fold_reduce(f, folding, rank, recv_data, buffer.data(), n, comm);
+    if (const int folded_rank{folding.folded_rank()}; folded_rank >= 0)
+      for (int distance{1}; distance < folding.size(); distance *= 2) {
+        const int partner{folding.unfolded_rank(folded_rank ^ distance)};
+        MPI_Sendrecv(recv_data, n, datatype, partner, collective_algorithm_tag, buffer.data(),
+                     n, datatype, partner, collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+        reduce_partial_results(f, buffer.data(), recv_data, n, partner < rank);
+      }
+    unfold_result(folding, rank, recv_data, n, comm);
+  }
+
+  // all-reduce by a reduce-scatter operation via recursive halving followed by an allgather
+  // operation via recursive doubling (Rabenseifner's algorithm), reduction operation need
+  // not be commutative
+  template<typename T, typename F>
+  void allreduce_rabenseifner(F f, const T *send_data, T *recv_data, int n, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    if (send_data != recv_data)
+      std::copy(send_data, send_data + n, recv_data);
+    std::vector<T> buffer(n);
+    const power_of_two_folding folding(rank, size);
+    fold_reduce(f, folding, rank, recv_data, buffer.data(), n, comm);
+    if (const int folded_rank{folding.folded_rank()}; folded_rank >= 0) {
+      // partners differ in a single bit of their folded ranks and hold the same range of
+      // elements, each keeps one half of the range, the bit determines which one
+      int first{0};
+      int last{n};
+      std::vector<int> splits;
+      for (int distance{1}; distance < folding.size(); distance *= 2) {
+        const int partner{folding.unfolded_rank(folded_rank ^ distance)};
+        const int mid{first + (last - first) / 2};
+        const bool keep_upper{(folded_rank & distance) != 0};
+        const int keep_first{keep_upper ? mid : first};
+        const int keep_last{keep_upper ? last : mid};
+        const int send_first{keep_upper ? first : mid};
+        const int send_last{keep_upper ? mid : last};
+        MPI_Sendrecv(recv_data + send_first, send_last - send_first, datatype, partner,
+                     collective_algorithm_tag, buffer.data(), keep_last - keep_first, datatype,
+                     partner, collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+        reduce_partial_results(f, buffer.data(), recv_data + keep_first, keep_last - keep_first,
+                               partner < rank);
+        splits.push_back(first);
+        splits.push_back(last);
+        first = keep_first;
+        last = keep_last;
+      }
+      for (int distance{folding.size() / 2}; distance >= 1; distance /= 2) {
+        const int partner{folding.unfolded_rank(folded_rank ^ distance)};
+        const int parent_last{splits.back()};
+        splits.pop_back();
+        const int parent_first{splits.back()};
+        splits.pop_back();
+        const int other_first{first == parent_first ? last : parent_first};
+        const int other_last{first == parent_first ? parent_last : first};
+        MPI_Sendrecv(recv_data + first, last - first, datatype, partner,
+                     collective_algorithm_tag, recv_data + other_first,
+                     other_last - other_first, datatype, partner, collective_algorithm_tag,
+                     comm, MPI_STATUS_IGNORE);
+        first = parent_first;
+        last = parent_last;
+      }
+    }
+    unfold_result(folding, rank, recv_data, n, comm);
+  }
+
+  // all-reduce by a reduce-scatter operation followed by an allgather operation along a ring
+  // of processes, bandwidth-optimal, reduction operation must be commutative, the data is
+  // split into one segment per process, segments are sent in chunks of chunk_bytes bytes (or
+  // as a whole if chunk_bytes is zero), a chunk is forwarded to the next process as soon as it
+  // has been received and reduced, such that communication and reduction overlap
+  template<typename T, typename F>
+  void allreduce_ring(F f, const T *send_data, T *recv_data, int n, MPI_Comm comm,
+                      std::size_t chunk_bytes = 0) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    if (send_data != recv_data)
+      std::copy(send_data, send_data + n, recv_data);
+    // the i-th segment, i may be negative, the last segment ends at n
+    const auto segment_first{[n, size](int i) {
+      return static_cast<int>(static_cast<long long>(n) * ((i % size + size) % size) / size);
+    }};
+    const auto segment_size{[n, size](int i) {
+      i = (i % size + size) % size;
+      return static_cast<int>(static_cast<long long>(n) * (i + 1) / size -
+                              static_cast<long long>(n) * i / size);
+    }};
+    const int chunk{chunk_bytes == 0
+                        ? std::max(n, 1)
+                        : static_cast<int>(std::max<std::size_t>(chunk_bytes / sizeof(T), 1))};
+    std::vector<T> buffer(n / size + 1);
+    const int left{(rank - 1 + size) % size};
+    const int right{(rank + 1) % size};
+    std::vector<MPI_Request> recv_requests;
+    std::vector<MPI_Request> send_requests;
+    const auto isend{[&](const T *data, int count) {
+      MPI_Request request;
+      MPI_Isend(data, count, datatype, right, collective_algorithm_tag, comm, &request);
+      send_requests.push_back(request);
+    }};
+    // passes segments along the ring in size - 1 steps, the segment that is received in one
+    // step is sent in the next step, received chunks are either reduced into or copied to
+    // the result
+    const auto pass{[&](int first_send_segment, bool reduce) {
+      for (int step{0}; step < size - 1; ++step) {
+        const int send_segment{first_send_segment - step};
+        const int recv_segment{send_segment - 1};
+        T *const recv_first{recv_data + segment_first(recv_segment)};
+        const int recv_count{segment_size(recv_segment)};
+        recv_requests.clear();
+        for (int i{0}; i < recv_count; i += chunk) {
+          MPI_Request request;
+          T *const first{reduce ? buffer.data() + i : recv_first + i};
+          MPI_Irecv(first, std::min(chunk, recv_count - i), datatype, left,
+                    collective_algorithm_tag, comm, &request);
+          recv_requests.push_back(request);
+        }
+        if (step == 0) {
+          const T *const send_first{recv_data + segment_first(send_segment)};
+          const int send_count{segment_size(send_segment)};
+          for (int i{0}; i < send_count; i += chunk)
+            isend(send_first + i, std::min(chunk, send_count - i));
+        }
+        for (int i{0}, j{0}; i < recv_count; i += chunk, ++j) {
+          const int count{std::min(chunk, recv_count - i)};
+          MPI_Wait(&recv_requests[j], MPI_STATUS_IGNORE);
+          if (reduce)
+            reduction_kernel(f, static_cast<const T *>(buffer.data() + i), recv_first + i,
+                             count);
+          if (step < size - 2)
+            isend(recv_first + i, count);
+        }
+      }
+      MPI_Waitall(static_cast<int>(send_requests.size()), send_requests.data(),
+                  MPI_STATUSES_IGNORE);
+      send_requests.clear();
+    }};
+    // after the reduce-scatter pass, each process holds the result of the segment with index
+    // rank + 1, which is the first segment it sends in the allgather pass
+    pass(rank, true);
+    pass(rank + 1, false);
+  }
+
+  // partial result of a sparse all-reduce operation on a vector of n elements, either in
+  // sparse representation as index-value pairs sorted by index or in dense representation as
+  // n values and a bit mask of the elements that are present
+  template<typename T>
+  class sparse_reduction_vector {
+    int n_;
+    bool is_dense_{false};
+    std::vector<value_index<T>> entries_;
+    std::vector<T> values_;
+    std::vector<unsigned char> present_;
+
+    [[nodiscard]] bool is_present(int i) const {
+      return (present_[i / 8] & (1u << (i % 8))) != 0;
+    }
+
+    void set_present(int i) {
+      present_[i / 8] |= static_cast<unsigned char>(1u << (i % 8));
+    }
+
+    void make_dense() {
+      values_.resize(n_);
+      present_.assign((n_ + 7) / 8, 0);
+      for (const auto &entry : entries_) {
+        values_[entry.index] = entry.value;
+        set_present(entry.index);
+      }
+      entries_.clear();
+      entries_.shrink_to_fit();
+      is_dense_ = true;
+    }
+
+    template<typename F>
+    void combine(F &f, int i, const T &other_value, bool other_is_left) {
+      if (is_present(i))
+        values_[i] = other_is_left ? f(other_value, values_[i]) : f(values_[i], other_value);
+      else {
+        values_[i] = other_value;
+        set_present(i);
+      }
+    }
+
+  public:
+    // entries must be sorted by index and indices must be unique
+    sparse_reduction_vector(int n, std::vector<value_index<T>> entries)
+        : n_{n}, entries_{std::move(entries)} {
+    }
+
+    // number of entries in sparse representation or -1 in dense representation, sent ahead
+    // of the entries such that the receiving process can allocate memory
+    [[nodiscard]] int header() const {
+      return is_dense_ ? -1 : static_cast<int>(entries_.size());
+    }
+
+    void post_send(int dest, MPI_Comm comm, std::vector<MPI_Request> &requests) const {
+      MPI_Request request;
+      if (is_dense_) {
+        MPI_Isend(values_.data(), n_, datatype_traits<T>::get_datatype(), dest,
+                  collective_algorithm_tag, comm, &request);
+        requests.push_back(request);
+        MPI_Isend(present_.data(), static_cast<int>(present_.size()), MPI_UNSIGNED_CHAR, dest,
+                  collective_algorithm_tag, comm, &request);
+      } else
+        MPI_Isend(entries_.data(), static_cast<int>(entries_.size()),
+                  datatype_traits<value_index<T>>::get_datatype(), dest,
+                  collective_algorithm_tag, comm, &request);
+      requests.push_back(request);
+    }
+
+    void post_recv(int header, int source, MPI_Comm comm, std::vector<MPI_Request> &requests) {
+      MPI_Request request;
+      is_dense_ = header < 0;
+      if (is_dense_) {
+        entries_.clear();
+        values_.resize(n_);
+        present_.resize((n_ + 7) / 8);
+        MPI_Irecv(values_.data(), n_, datatype_traits<T>::get_datatype(), source,
+                  collective_algorithm_tag, comm, &request);
+        requests.push_back(request);
+        MPI_Irecv(present_.data(), static_cast<int>(present_.size()), MPI_UNSIGNED_CHAR,
+                  source, collective_algorithm_tag, comm, &request);
+      } else {
+        entries_.resize(header);
+        MPI_Irecv(entries_.data(), header, datatype_traits<value_index<T>>::get_datatype(),
+                  source, collective_algorithm_tag, comm, &request);
+      }
+      requests.push_back(request);
+    }
+
+    // combines the partial result of another process with this partial result, switches to
+    // the dense representation if the number of entries exceeds max_entries
+    template<typename F>
+    void merge(F &f, const sparse_reduction_vector &other, bool other_is_left,
+               std::size_t max_entries) {
+      if (not is_dense_ and not other.is_dense_) {
+        std::vector<value_index<T>> entries;
+        entries.reserve(entries_.size() + other.entries_.size());
+        auto i{entries_.begin()};
+        auto j{other.entries_.begin()};
+        while (i != entries_.end() and j != other.entries_.end()) {
+          if (i->index < j->index)
+            entries.push_back(*(i++));
+          else if (j->index < i->index)
+            entries.push_back(*(j++));
+          else {
+            entries.push_back(
+                {other_is_left ? f(j->value, i->value) : f(i->value, j->value), i->index});
+            ++i;
+            ++j;
+          }
+        }
+        entries.insert(entries.end(), i, entries_.end());
+        entries.insert(entries.end(), j, other.entries_.end());
+        entries_.swap(entries);
+        if (entries_.size() > max_entries)
+          make_dense();
+        return;
+      }
+      if (not is_dense_)
+        make_dense();
+      if (other.is_dense_) {
+        for (int i{0}; i < n_; ++i)
+          if (other.is_present(i))
+            combine(f, i, other.values_[i], other_is_left);
+      } else
+        for (const auto &entry : other.entries_)
+          combine(f, entry.index, entry.value, other_is_left);
+    }
+
+    // final result in sparse representation
+    [[nodiscard]] std::vector<value_index<T>> entries() && {
+      if (not is_dense_)
+        return std::move(entries_);
+      std::vector<value_index<T>> entries;
+      for (int i{0}; i < n_; ++i)
+        if (is_present(i))
+          entries.push_back({values_[i], i});
+      return entries;
+    }
+  };
+
+  // sparse all-reduce by recursive doubling, partial results are merged as sorted index-value
+  // pairs and are switched to a dense representation as soon as the number of entries exceeds
+  // max_entries, reduction operation need not be commutative
+  template<typename T, typename F>
+  std::vector<value_index<T>> sparse_allreduce_recursive_doubling(
+      F f, int n, std::vector<value_index<T>> entries, std::size_t max_entries,
+      MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    sparse_reduction_vector<T> data(n, std::move(entries));
+    sparse_reduction_vector<T> buffer(n, {});
+    std::vector<MPI_Request> requests;
+    const auto wait_all{[&requests]() {
+      MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+      requests.clear();
+    }};
+    const auto send{[&](int dest) {
+      const int header{data.header()};
+      MPI_Send(&header, 1, MPI_INT, dest, collective_algorithm_tag, comm);
+      data.post_send(dest, comm, requests);
+      wait_all();
+    }};
+    const auto recv{[&](int source) {
+      int header;
+      MPI_Recv(&header, 1, MPI_INT, source, collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+      buffer.post_recv(header, source, comm, requests);
+      wait_all();
+    }};
+    const power_of_two_folding folding(rank, size);
+    if (folding.is_paired()) {
+      if (rank % 2 == 0)
+        send(folding.pair_rank());
+      else {
+        recv(folding.pair_rank());
+        data.merge(f, buffer, true, max_entries);
+      }
+    }
+    if (const int folded_rank{folding.folded_rank()}; folded_rank >= 0)
+      for (int distance{1}; distance < folding.size(); distance *= 2) {
+        const int partner{folding.unfolded_rank(folded_rank ^ distance)};
+        const int header{data.header()};
+        int partner_header;
+        MPI_Sendrecv(&header, 1, MPI_INT, partner, collective_algorithm_tag, &partner_header, 1,
+                     MPI_INT, partner, collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+        buffer.post_recv(partner_header, partner, comm, requests);
+        data.post_send(partner, comm, requests);
+        wait_all();
+        data.merge(f, buffer, partner < rank, max_entries);
+      }
+    if (folding.is_paired()) {
+      if (rank % 2 == 0) {
+        recv(folding.pair_rank());
+        return std::move(buffer).entries();
+      }
+      send(folding.pair_rank());
+    }
+    return std::move(data).entries();
+  }
+
+  // broadcast along a binomial tree rooted at the root process
+  template<typename T>
+  void bcast_binomial(int root_rank, T *data, int n, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    const int relative_rank{(rank - root_rank + size) % size};
+    int mask{1};
+    for (; mask < size; mask *= 2)
+      if ((relative_rank & mask) != 0) {
+        MPI_Recv(data, n, datatype, (rank - mask + size) % size, collective_algorithm_tag,
+                 comm, MPI_STATUS_IGNORE);
+        break;
+      }
+    for (mask /= 2; mask > 0; mask /= 2)
+      if (relative_rank + mask < size)
+        MPI_Send(data, n, datatype, (rank + mask) % size, collective_algorithm_tag, comm);
+  }
+
+  // broadcast along a chain of processes starting at the root process, the data is split
+  // into segments, such that the transfer of consecutive segments is pipelined
+  template<typename T>
+  void bcast_pipelined_chain(int root_rank, T *data, int n, MPI_Comm comm,
+                             std::size_t segment_bytes) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    const int relative_rank{(rank - root_rank + size) % size};
+    const int segment{static_cast<int>(std::max<std::size_t>(segment_bytes / sizeof(T), 1))};
+    std::vector<MPI_Request> requests;
+    requests.reserve(n / segment + 1);
+    for (int first{0}; first < n; first += segment) {
+      const int count{std::min(segment, n - first)};
+      if (relative_rank > 0)
+        MPI_Recv(data + first, count, datatype, (rank - 1 + size) % size,
+                 collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+      if (relative_rank < size - 1) {
+        MPI_Request request;
+        MPI_Isend(data + first, count, datatype, (rank + 1) % size, collective_algorithm_tag,
+                  comm, &request);
+        requests.push_back(request);
+      }
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  }
+
+  // all-to-all exchange in size steps, in each step every process sends to one process and
+  // receives from another one, displacements are given in bytes
+  template<typename T>
+  void alltoallv_pairwise(const T *send_data, const int *sendcounts,
+                          const MPI_Aint *senddispls, T *recv_data, const int *recvcounts,
+                          const MPI_Aint *recvdispls, MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    for (int step{0}; step < size; ++step) {
+      const int dest{(rank + step) % size};
+      const int source{(rank - step + size) % size};
+      MPI_Sendrecv(displaced(send_data, senddispls[dest]), sendcounts[dest], datatype, dest,
+                   collective_algorithm_tag, displaced(recv_data, recvdispls[source]),
+                   recvcounts[source], datatype, source, collective_algorithm_tag, comm,
+                   MPI_STATUS_IGNORE);
+    }
+  }
+
+  // all-to-all exchange in ceil(log2(size)) steps (Bruck's algorithm), data is forwarded via
+  // intermediate processes, block sizes are sent along with the data, displacements are
+  // given in bytes
+  template<typename T>
+  void alltoallv_bruck(const T *send_data, const int *sendcounts, const MPI_Aint *senddispls,
+                       T *recv_data, const int *recvcounts, const MPI_Aint *recvdispls,
+                       MPI_Comm comm) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Datatype datatype{datatype_traits<T>::get_datatype()};
+    // the i-th block holds data for the process with rank (rank + i) % size, when the
+    // algorithm has finished, the i-th block holds data from process (rank - i) % size
+    std::vector<std::vector<T>> blocks(size);
+    for (int i{0}; i < size; ++i) {
+      const int dest{(rank + i) % size};
+      const T *first{displaced(send_data, senddispls[dest])};
+      blocks[i].assign(first, first + sendcounts[dest]);
+    }
+    std::vector<int> send_block_sizes;
+    std::vector<int> recv_block_sizes;
+    std::vector<T> send_buffer;
+    std::vector<T> recv_buffer;
+    for (int distance{1}; distance < size; distance *= 2) {
+      const int dest{(rank + distance) % size};
+      const int source{(rank - distance + size) % size};
+      send_block_sizes.clear();
+      send_buffer.clear();
+      for (int i{distance}; i < size; ++i)
+        if ((i & distance) != 0) {
+          send_block_sizes.push_back(static_cast<int>(blocks[i].size()));
+          send_buffer.insert(send_buffer.end(), blocks[i].begin(), blocks[i].end());
+        }
+      recv_block_sizes.resize(send_block_sizes.size());
+      MPI_Sendrecv(send_block_sizes.data(), static_cast<int>(send_block_sizes.size()), MPI_INT,
+                   dest, collective_algorithm_tag, recv_block_sizes.data(),
+                   static_cast<int>(recv_block_sizes.size()), MPI_INT, source,
+                   collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+      int recv_count{0};
+      for (const int block_size : recv_block_sizes)
+        recv_count += block_size;
+      recv_buffer.resize(recv_count);
+      MPI_Sendrecv(send_buffer.data(), static_cast<int>(send_buffer.size()), datatype, dest,
+                   collective_algorithm_tag, recv_buffer.data(), recv_count, datatype, source,
+                   collective_algorithm_tag, comm, MPI_STATUS_IGNORE);
+      auto block_first{recv_buffer.begin()};
+      auto block_size{recv_block_sizes.begin()};
+      for (int i{distance}; i < size; ++i)
+        if ((i & distance) != 0) {
+          blocks[i].assign(block_first, block_first + *block_size);
+          block_first += *block_size;
+          ++block_size;
+        }
+    }
+    for (int i{0}; i < size; ++i) {
+      const int source{(rank - i + size) % size};
+      const auto count{
+          std::min(blocks[i].size(), static_cast<std::size_t>(recvcounts[source]))};
+      std::copy(blocks[i].begin(), blocks[i].begin() + count,
+                displaced(recv_data, recvdispls[source]));
+    }
+  }
+
+}  // namespace mpl::detail
+
+
+namespace mpl {
+
+  /// Policy that selects a bandwidth-optimal all-reduce algorithm, which passes the data in
+  /// segments along a ring of processes.  Each segment is sent in chunks, a chunk is forwarded
+  /// to the next process as soon as it has been received and reduced, such that communication
+  /// and the evaluation of the reduction operation overlap.  This algorithm is well suited for
+  /// large buffers and for expensive user-defined reduction operations.
+  /// \note The ring algorithm requires a commutative reduction operation, see \ref op_traits.
+  /// If the reduction operation is not commutative or the number of elements is less than the
+  /// communicator size, the all-reduce operation is carried out by MPI.
+  class ring_allreduce {
+    std::size_t chunk_bytes_;
+
+  public:
+    /// \param chunk_bytes size of the chunks in bytes that are sent along the ring
+    explicit ring_allreduce(std::size_t chunk_bytes = std::size_t{1} << 16)
+        : chunk_bytes_{chunk_bytes} {
+    }
+
+    /// \return size of the chunks in bytes that are sent along the ring
+    [[nodiscard]] std::size_t chunk_size() const {
+      return chunk_bytes_;
+    }
+  };
+
+}  // namespace mpl
+
+#endif
@@ -3,10 +3,17 @@
 #define MPL_COMM_GROUP_HPP
 
 #include <mpi.h>
+#include <algorithm>
+#include <map>
 #include <type_traits>
-#include <thread>
+#include <memory>
 #include <optional>
 #include <mpl/layout.hpp>
+#include <mpl/allreduce_batch.hpp>
+#include <mpl/collective_algorithms.hpp>
+#include <mpl/csr_vector.hpp>
+#include <mpl/packed_message.hpp>
+#include <mpl/serialization.hpp>
 #include <mpl/vector.hpp>
 #include <mpl/command_line.hpp>
 #include <mpl/info.hpp>
@@ -278,37 +285,209 @@ namespace mpl {
 
     class base_communicator {
     protected:
-      struct isend_irecv_request_state {
-        MPI_Datatype datatype{MPI_DATATYPE_NULL};
-        int count{MPI_UNDEFINED};
-        int source{MPI_ANY_SOURCE};
-        int tag{MPI_ANY_TAG};
+      using isend_function = int (*)(const void *, int, MPI_Datatype, int, int, MPI_Comm,
+                                     MPI_Request *);
+
+      // sends a copy of an STL container, which is serialized into a contiguous buffer
+      template<typename T>
+      class isend_task final : public progress_task {
+        detail::vector<T> data_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool cancelled_{false};
+
+      public:
+        template<typename C>
+        isend_task(isend_function isend, const C &data, int destination, tag_t t, MPI_Comm comm)
+            : data_(data.size(), std::begin(data)) {
+          isend(data_.data(), static_cast<int>(data_.size()),
+                detail::datatype_traits<T>::get_datatype(), destination, static_cast<int>(t),
+                comm, &req_);
+        }
+
+        bool progress() override {
+          if (cancel_requested() and not cancelled_) {
+            MPI_Cancel(&req_);
+            cancelled_ = true;
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          complete(s);
+          return true;
+        }
       };
 
-      struct isend_irecv_state {
-        MPI_Request req{};
-        isend_irecv_request_state *request_state{nullptr};
+      // receives an STL container of a priori unknown size, probes for the incoming message
+      // first and starts the actual receive operation as soon as the message size is known
+      template<typename T, typename C>
+      class irecv_task final : public progress_task {
+        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        // contiguous containers are received in place, this includes strings, which are
+        // read-only containers in general but can be written to after resizing
+        static constexpr bool is_contiguous{
+            std::is_base_of_v<detail::contiguous_stl_container, C> or
+            (std::is_base_of_v<detail::contiguous_const_stl_container, C> and
+             detail::has_resize_v<T>)};
+
+        T &data_;
+        int source_;
+        int tag_;
+        MPI_Comm comm_;
+        std::unique_ptr<detail::vector<value_type>> serial_data_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool probed_{false};
+
+        bool probe() {
+          int flag;
+          MPI_Message message;
+          MPI_Status s;
+          MPI_Improbe(source_, tag_, comm_, &flag, &message, &s);
+          if (flag == 0)
+            return false;
+          int count{0};
+          MPI_Get_count(&s, detail::datatype_traits<value_type>::get_datatype(), &count);
+#if defined MPL_DEBUG
+          if (count == MPI_UNDEFINED)
+            throw invalid_count();
+#endif
+          value_type *buffer;
+          if constexpr (is_contiguous) {
+            if constexpr (detail::has_resize_v<T>)
+              data_.resize(count);
+            buffer = data_.size() > 0 ? &data_[0] : nullptr;
+          } else {
+            serial_data_ =
+                std::make_unique<detail::vector<value_type>>(count, detail::uninitialized{});
+            buffer = serial_data_->data();
+          }
+          MPI_Imrecv(buffer, count, detail::datatype_traits<value_type>::get_datatype(),
+                     &message, &req_);
+          probed_ = true;
+          return true;
+        }
+
+      public:
+        irecv_task(T &data, int source, tag_t t, MPI_Comm comm)
+            : data_{data}, source_{source}, tag_{static_cast<int>(t)}, comm_{comm} {
+        }
+
+        bool progress() override {
+          if (not probed_) {
+            if (cancel_requested()) {
+              complete_cancelled();
+              return true;
+            }
+            if (not probe())
+              return false;
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          if constexpr (not is_contiguous) {
+            T new_data(serial_data_->begin(), serial_data_->end());
+            data_.swap(new_data);
+            serial_data_.reset();
+          }
+          complete(s);
+          return true;
+        }
       };
 
-      static int isend_irecv_query(void *state, MPI_Status *s) {
-        auto *request_state{static_cast<isend_irecv_request_state *>(state)};
-        MPI_Status_set_elements(s, request_state->datatype, request_state->count);
-        MPI_Status_set_cancelled(s, 0);
-        s->MPI_SOURCE = request_state->source;
-        s->MPI_TAG = request_state->tag;
-        return MPI_SUCCESS;
-      }
+      // sends a serialized copy of an object
+      template<typename T>
+      class serialized_isend_task final : public progress_task {
+        detail::pooled_buffer buffer_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool cancelled_{false};
 
-      static int isend_irecv_free(void *state) {
-        auto *request_state{static_cast<isend_irecv_request_state *>(state)};
-        delete request_state;
-        return MPI_SUCCESS;
-      }
+      public:
+        serialized_isend_task(isend_function isend, const T &data, int destination, tag_t t,
+                              MPI_Comm comm) {
+          output_archive ar(buffer_.get());
+          ar << data;
+#if defined MPL_DEBUG
+          if (ar.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            throw invalid_count();
+#endif
+          isend(ar.data(), static_cast<int>(ar.size()), MPI_BYTE, destination,
+                static_cast<int>(t), comm, &req_);
+        }
 
-      static int isend_irecv_cancel([[maybe_unused]] void *state,
-                                    [[maybe_unused]] int complete) {
-        return MPI_SUCCESS;
-      }
+        bool progress() override {
+          if (cancel_requested() and not cancelled_) {
+            MPI_Cancel(&req_);
+            cancelled_ = true;
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          complete(s);
+          return true;
+        }
+      };
+
+      // receives a serialized object, probes for the incoming message first and starts the
+      // actual receive operation as soon as the message size is known
+      template<typename T>
+      class serialized_irecv_task final : public progress_task {
+        T &data_;
+        int source_;
+        int tag_;
+        MPI_Comm comm_;
+        detail::pooled_buffer buffer_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool probed_{false};
+        bool no_proc_{false};
+
+        bool probe() {
+          int flag;
+          MPI_Message message;
+          MPI_Status s;
+          MPI_Improbe(source_, tag_, comm_, &flag, &message, &s);
+          if (flag == 0)
+            return false;
+          no_proc_ = message == MPI_MESSAGE_NO_PROC;
+          int count{0};
+          MPI_Get_count(&s, MPI_BYTE, &count);
+          buffer_.get().resize(count);
+          MPI_Imrecv(buffer_.get().data(), count, MPI_BYTE, &message, &req_);
+          probed_ = true;
+          return true;
+        }
+
+      public:
+        serialized_irecv_task(T &data, int source, tag_t t, MPI_Comm comm)
+            : data_{data}, source_{source}, tag_{static_cast<int>(t)}, comm_{comm} {
+        }
+
+        bool progress() override {
+          if (not probed_) {
+            if (cancel_requested()) {
+              complete_cancelled();
+              return true;
+            }
+            if (not probe())
+              return false;
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          if (not no_proc_) {
+            input_archive ar(buffer_.get().data(), buffer_.get().size());
+            ar >> data_;
+          }
+          complete(s);
+          return true;
+        }
+      };
 
       void check_dest([[maybe_unused]] int dest) const {
 #if defined MPL_DEBUG
@@ -400,10 +579,71 @@ namespace mpl {
 #endif
       }
 
+      template<typename T>
+      void check_container_size([[maybe_unused]] const T &container,
+                                detail::serialized_type) const {
+      }
+
       template<typename T>
       void check_container_size(const T &container) const {
-        check_container_size(container,
-                             typename detail::datatype_traits<T>::data_type_category{});
+        check_container_size(container, detail::transfer_category_t<T>{});
+      }
+
+      // Non-contiguous STL containers are sent by blocking operations in place via a hindexed
+      // data type of the addresses of their elements (see iterator_layout) if the message is
+      // large and the elements are stored in few contiguous blocks, e.g., the elements of a
+      // std::deque.  Otherwise, the elements are copied into a contiguous buffer first, which
+      // is faster than sending many small blocks.  The fragmentation is estimated from a prefix
+      // of the container.  Non-blocking operations always copy, such that the container may be
+      // modified or destroyed while the operation is still in progress.
+      static constexpr std::size_t in_place_send_min_bytes{std::size_t{1} << 16};
+      static constexpr std::size_t in_place_send_min_block_bytes{256};
+      static constexpr std::size_t in_place_send_sample_size{256};
+
+      template<typename T>
+      using in_place_send_value_t =
+          detail::remove_const_from_members_t<typename T::value_type>;
+
+      template<typename T>
+      static std::optional<iterator_layout<in_place_send_value_t<T>>> in_place_send_layout(
+          const T &data) {
+        using value_type = in_place_send_value_t<T>;
+        if constexpr (std::is_reference_v<decltype(*std::begin(data))>) {
+          if (data.size() * sizeof(value_type) < in_place_send_min_bytes)
+            return {};
+          std::size_t elements{0};
+          std::size_t blocks{0};
+          const char *next{nullptr};
+          for (auto i{std::begin(data)};
+               i != std::end(data) and elements < in_place_send_sample_size; ++i, ++elements) {
+            const char *address{reinterpret_cast<const char *>(&(*i))};
+            if (address != next)
+              ++blocks;
+            next = address + sizeof(value_type);
+          }
+          if (elements * sizeof(value_type) < blocks * in_place_send_min_block_bytes)
+            return {};
+          return iterator_layout<value_type>(std::begin(data), std::end(data));
+        } else
+          return {};
+      }
+
+      template<typename T>
+      static const in_place_send_value_t<T> *in_place_send_data(const T &data) {
+        if constexpr (std::is_reference_v<decltype(*std::begin(data))>)
+          return reinterpret_cast<const in_place_send_value_t<T> *>(&(*std::begin(data)));
+        else
+          return nullptr;
+      }
+
+      template<typename iterT>
+      int distance_as_int(iterT begin, iterT end) const {
+        const auto distance{std::distance(begin, end)};
+#if defined MPL_DEBUG
+        if (distance > static_cast<decltype(distance)>(std::numeric_limits<int>::max()))
+          throw invalid_count();
+#endif
+        return static_cast<int>(distance);
       }
 
       template<typename T>
@@ -422,12 +662,13 @@ namespace mpl {
         displs_as_int.reserve(displs.size());
         std::transform(displs.begin(), displs.end(), std::back_inserter(displs_as_int),
                        [](const auto &displ) {
+                         constexpr MPI_Aint size{static_cast<MPI_Aint>(sizeof(T))};
 #if defined MPL_DEBUG
-                         if (displ / sizeof(T) * sizeof(T) != displ or
-                             displ / sizeof(T) > std::numeric_limits<int>::max)
+                         if (displ % size != 0 or
+                             displ / size > MPI_Aint{std::numeric_limits<int>::max()})
                            throw invalid_displacement();
 #endif
-                         return static_cast<int>(displ / sizeof(T));
+                         return static_cast<int>(displ / size);
                        });
         return displs_as_int;
       }
@@ -446,6 +687,39 @@ namespace mpl {
         return displs_as_int;
       }
 
+      // persistent request of an operation that is emulated by a non-blocking operation,
+      // which is started by the given function object each time the request is started
+      template<typename F>
+      static prequest emulated_prequest(F &&start) {
+        return base_prequest{MPI_REQUEST_NULL,
+                             std::make_shared<emulated_persistent_operation<std::decay_t<F>>>(
+                                 std::forward<F>(start))};
+      }
+
+      // arguments of an all-to-all operation with individual data types, the layouts keep
+      // the data types alive as long as a persistent request refers to them
+      template<typename T>
+      struct alltoallw_arguments {
+        layouts<T> sendls;
+        layouts<T> recvls;
+        std::vector<int> counts;
+        std::vector<int> senddispls;
+        std::vector<MPI_Datatype> sendtypes;
+        std::vector<int> recvdispls;
+        std::vector<MPI_Datatype> recvtypes;
+
+        alltoallw_arguments(const layouts<T> &sendls_, std::vector<int> &&senddispls_,
+                            const layouts<T> &recvls_, std::vector<int> &&recvdispls_)
+            : sendls{sendls_},
+              recvls{recvls_},
+              counts(recvls_.size(), 1),
+              senddispls{std::move(senddispls_)},
+              sendtypes{sendls_.datatypes()},
+              recvdispls{std::move(recvdispls_)},
+              recvtypes{recvls_.datatypes()} {
+        }
+      };
+
       MPI_Comm comm_{MPI_COMM_NULL};
 
     public:
@@ -600,16 +874,37 @@ namespace mpl {
       void send(const T &data, int destination, tag_t t,
                 detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const vector_layout<value_type> l(data.size());
-        send(data.size() > 0 ? &data[0] : nullptr, l, destination, t);
+        MPI_Send(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                 detail::datatype_traits<value_type>::get_datatype(), destination,
+                 static_cast<int>(t), comm_);
       }
 
       template<typename T>
       void send(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if (const auto l{in_place_send_layout(data)}) {
+          MPI_Send(in_place_send_data(data), 1,
+                   detail::datatype_traits<layout<value_type>>::get_datatype(*l), destination,
+                   static_cast<int>(t), comm_);
+          return;
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        const vector_layout<value_type> l(serial_data.size());
-        send(serial_data.data(), l, destination, t);
+        MPI_Send(serial_data.data(), static_cast<int>(serial_data.size()),
+                 detail::datatype_traits<value_type>::get_datatype(), destination,
+                 static_cast<int>(t), comm_);
+      }
+
+      template<typename T>
+      void send(const T &data, int destination, tag_t t, detail::serialized_type) const {
+        detail::pooled_buffer buffer;
+        output_archive ar(buffer.get());
+        ar << data;
+#if defined MPL_DEBUG
+        if (ar.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+          throw invalid_count();
+#endif
+        MPI_Send(ar.data(), static_cast<int>(ar.size()), MPI_BYTE, destination,
+                 static_cast<int>(t), comm_);
       }
 
     public:
@@ -628,7 +923,7 @@ namespace mpl {
         check_dest(destination);
         check_send_tag(t);
         check_container_size(data);
-        send(data, destination, t, typename detail::datatype_traits<T>::data_type_category{});
+        send(data, destination, t, detail::transfer_category_t<T>{});
       }
 
       /// Sends a message with several values having a specific memory layout via a
@@ -666,14 +961,29 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          send(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Send(&(*begin), distance_as_int(begin, end),
+                   detail::datatype_traits<value_type>::get_datatype(), destination,
+                   static_cast<int>(t), comm_);
         } else {
           const iterator_layout<value_type> l(begin, end);
           send(&(*begin), l, destination, t);
         }
       }
 
+      /// Sends a packed message via a blocking standard send operation.
+      /// \param message packed message to send, must have been created for this communicator
+      /// \param destination rank of the receiving process
+      /// \param t tag associated to this message
+      /// \see \c packed_message
+      void send(const packed_message &message, int destination, tag_t t = tag_t{0}) const {
+        check_dest(destination);
+        check_send_tag(t);
+        MPI_Send(message.data(), message.size(), MPI_PACKED, destination, static_cast<int>(t),
+                 comm_);
+      }
+
       // --- non-blocking standard send ---
     private:
       template<typename T>
@@ -686,46 +996,30 @@ namespace mpl {
       }
 
       template<typename T>
-      void isend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                 detail::contiguous_const_stl_container) const {
+      base_irequest isend(const T &data, int destination, tag_t t,
+                          detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
         MPI_Request req;
-        MPI_Isend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
+        MPI_Isend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
                   static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
+        return base_irequest{req};
       }
 
       template<typename T>
-      void isend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                 detail::stl_container) const {
+      base_irequest isend(const T &data, int destination, tag_t t,
+                          detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        const detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        isend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<isend_task<value_type>>(MPI_Isend, data, destination, t, comm_))};
       }
 
-      template<typename T, typename C>
-      base_irequest isend(const T &data, int destination, tag_t t, C) const {
-        auto *request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto *send_state{new isend_irecv_state()};
-        send_state->req = req;
-        send_state->request_state = request_state;
-        std::thread thread([this, &data, destination, t, send_state]() {
-          isend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+      template<typename T>
+      base_irequest isend(const T &data, int destination, tag_t t,
+                          detail::serialized_type) const {
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<serialized_isend_task<T>>(MPI_Isend, data, destination, t,
+                                                       comm_))};
       }
 
     public:
@@ -740,13 +1034,15 @@ namespace mpl {
       /// \note Sending STL containers is a  convenience feature, which may have non-optimal
       /// performance characteristics. Use alternative overloads in performance-critical code
       /// sections.
+      /// \note Transfers of STL containers, which are not stored contiguously in memory, and
+      /// receive operations of STL containers are driven by MPL itself.  They make progress
+      /// whenever a request is tested or waited for via MPL.
       template<typename T>
       irequest isend(const T &data, int destination, tag_t t = tag_t{0}) const {
         check_dest(destination);
         check_send_tag(t);
         check_container_size(data);
-        return isend(data, destination, t,
-                     typename detail::datatype_traits<T>::data_type_category{});
+        return isend(data, destination, t, detail::transfer_category_t<T>{});
       }
 
       /// Sends a message with several values having a specific memory layout via a
@@ -789,14 +1085,36 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return isend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Isend(&(*begin), distance_as_int(begin, end),
+                    detail::datatype_traits<value_type>::get_datatype(), destination,
+                    static_cast<int>(t), comm_, &req);
+          return base_irequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return isend(&(*begin), l, destination, t);
         }
       }
 
+      /// Sends a packed message via a non-blocking standard send operation.
+      /// \param message packed message to send, must have been created for this communicator
+      /// \param destination rank of the receiving process
+      /// \param t tag associated to this message
+      /// \return request representing the ongoing message transfer
+      /// \note The packed message must neither be modified nor destroyed before the send
+      /// operation has been completed.
+      /// \see \c packed_message
+      irequest isend(const packed_message &message, int destination, tag_t t = tag_t{0}) const {
+        check_dest(destination);
+        check_send_tag(t);
+        MPI_Request req;
+        MPI_Isend(message.data(), message.size(), MPI_PACKED, destination, static_cast<int>(t),
+                  comm_, &req);
+        return base_irequest{req};
+      }
+
       // --- persistent standard send ---
       /// Creates a persistent communication request to send a message with a single
       /// value via a blocking standard send operation.
@@ -855,8 +1173,13 @@ namespace mpl {
       prequest send_init(iterT begin, iterT end, int destination, tag_t t = tag_t{0}) const {
         using value_type = typename std::iterator_traits<iterT>::value_type;
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return send_init(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Send_init(&(*begin), distance_as_int(begin, end),
+                        detail::datatype_traits<value_type>::get_datatype(), destination,
+                        static_cast<int>(t), comm_, &req);
+          return base_prequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return send_init(&(*begin), l, destination, t);
@@ -907,16 +1230,18 @@ namespace mpl {
       void bsend(const T &data, int destination, tag_t t,
                  detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const vector_layout<value_type> l(data.size());
-        bsend(data.size() > 0 ? &data[0] : nullptr, l, destination, t);
+        MPI_Bsend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
+                  static_cast<int>(t), comm_);
       }
 
       template<typename T>
       void bsend(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        const vector_layout<value_type> l(serial_data.size());
-        bsend(serial_data.data(), l, destination, t);
+        MPI_Bsend(serial_data.data(), static_cast<int>(serial_data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
+                  static_cast<int>(t), comm_);
       }
 
     public:
@@ -974,8 +1299,11 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          bsend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Bsend(&(*begin), distance_as_int(begin, end),
+                    detail::datatype_traits<value_type>::get_datatype(), destination,
+                    static_cast<int>(t), comm_);
         } else {
           const iterator_layout<value_type> l(begin, end);
           bsend(&(*begin), l, destination, t);
@@ -994,44 +1322,21 @@ namespace mpl {
       }
 
       template<typename T>
-      void ibsend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                  detail::contiguous_const_stl_container) const {
+      irequest ibsend(const T &data, int destination, tag_t t,
+                      detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
         MPI_Request req;
-        MPI_Ibsend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
+        MPI_Ibsend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                   detail::datatype_traits<value_type>::get_datatype(), destination,
                    static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
+        return base_irequest{req};
       }
 
       template<typename T>
-      void ibsend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                  detail::stl_container) const {
+      irequest ibsend(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        ibsend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
-      template<typename T, typename C>
-      irequest ibsend(const T &data, int destination, tag_t t, C) const {
-        auto *request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto *send_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, destination, t, send_state]() {
-          ibsend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<isend_task<value_type>>(MPI_Ibsend, data, destination, t, comm_))};
       }
 
     public:
@@ -1096,8 +1401,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return ibsend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Ibsend(&(*begin), distance_as_int(begin, end),
+                     detail::datatype_traits<value_type>::get_datatype(), destination,
+                     static_cast<int>(t), comm_, &req);
+          return base_irequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return ibsend(&(*begin), l, destination, t);
@@ -1164,8 +1474,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return bsend_init(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Bsend_init(&(*begin), distance_as_int(begin, end),
+                         detail::datatype_traits<value_type>::get_datatype(), destination,
+                         static_cast<int>(t), comm_, &req);
+          return base_prequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return bsend_init(&(*begin), l, destination, t);
@@ -1186,16 +1501,24 @@ namespace mpl {
       void ssend(const T &data, int destination, tag_t t,
                  detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const vector_layout<value_type> l(data.size());
-        ssend(data.size() > 0 ? &data[0] : nullptr, l, destination, t);
+        MPI_Ssend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
+                  static_cast<int>(t), comm_);
       }
 
       template<typename T>
       void ssend(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if (const auto l{in_place_send_layout(data)}) {
+          MPI_Ssend(in_place_send_data(data), 1,
+                    detail::datatype_traits<layout<value_type>>::get_datatype(*l), destination,
+                    static_cast<int>(t), comm_);
+          return;
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        const vector_layout<value_type> l(serial_data.size());
-        ssend(serial_data.data(), l, destination, t);
+        MPI_Ssend(serial_data.data(), static_cast<int>(serial_data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
+                  static_cast<int>(t), comm_);
       }
 
     public:
@@ -1251,8 +1574,11 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          ssend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Ssend(&(*begin), distance_as_int(begin, end),
+                    detail::datatype_traits<value_type>::get_datatype(), destination,
+                    static_cast<int>(t), comm_);
         } else {
           const iterator_layout<value_type> l(begin, end);
           ssend(&(*begin), l, destination, t);
@@ -1271,44 +1597,21 @@ namespace mpl {
       }
 
       template<typename T>
-      void issend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                  detail::contiguous_const_stl_container) const {
+      irequest issend(const T &data, int destination, tag_t t,
+                      detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
         MPI_Request req;
-        MPI_Issend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
+        MPI_Issend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                   detail::datatype_traits<value_type>::get_datatype(), destination,
                    static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
+        return base_irequest{req};
       }
 
       template<typename T>
-      void issend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                  detail::stl_container) const {
+      irequest issend(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        issend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
-      template<typename T, typename C>
-      irequest issend(const T &data, int destination, tag_t t, C) const {
-        auto *request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto *send_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, destination, t, send_state]() {
-          issend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<isend_task<value_type>>(MPI_Issend, data, destination, t, comm_))};
       }
 
     public:
@@ -1373,8 +1676,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return issend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Issend(&(*begin), distance_as_int(begin, end),
+                     detail::datatype_traits<value_type>::get_datatype(), destination,
+                     static_cast<int>(t), comm_, &req);
+          return base_irequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return issend(&(*begin), l, destination, t);
@@ -1441,8 +1749,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return ssend_init(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Ssend_init(&(*begin), distance_as_int(begin, end),
+                         detail::datatype_traits<value_type>::get_datatype(), destination,
+                         static_cast<int>(t), comm_, &req);
+          return base_prequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return ssend_init(&(*begin), l, destination, t);
@@ -1463,16 +1776,24 @@ namespace mpl {
       void rsend(const T &data, int destination, tag_t t,
                  detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const vector_layout<value_type> l(data.size());
-        rsend(data.size() > 0 ? &data[0] : nullptr, l, destination, t);
+        MPI_Rsend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
+                  static_cast<int>(t), comm_);
       }
 
       template<typename T>
       void rsend(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if (const auto l{in_place_send_layout(data)}) {
+          MPI_Rsend(in_place_send_data(data), 1,
+                    detail::datatype_traits<layout<value_type>>::get_datatype(*l), destination,
+                    static_cast<int>(t), comm_);
+          return;
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        const vector_layout<value_type> l(serial_data.size());
-        rsend(serial_data.data(), l, destination, t);
+        MPI_Rsend(serial_data.data(), static_cast<int>(serial_data.size()),
+                  detail::datatype_traits<value_type>::get_datatype(), destination,
+                  static_cast<int>(t), comm_);
       }
 
     public:
@@ -1529,8 +1850,11 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          rsend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Rsend(&(*begin), distance_as_int(begin, end),
+                    detail::datatype_traits<value_type>::get_datatype(), destination,
+                    static_cast<int>(t), comm_);
         } else {
           const iterator_layout<value_type> l(begin, end);
           rsend(&(*begin), l, destination, t);
@@ -1549,44 +1873,21 @@ namespace mpl {
       }
 
       template<typename T>
-      void irsend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                  detail::contiguous_const_stl_container) const {
+      irequest irsend(const T &data, int destination, tag_t t,
+                      detail::contiguous_const_stl_container) const {
         using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
         MPI_Request req;
-        MPI_Irsend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
+        MPI_Irsend(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                   detail::datatype_traits<value_type>::get_datatype(), destination,
                    static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
+        return base_irequest{req};
       }
 
       template<typename T>
-      void irsend(const T &data, int destination, tag_t t, isend_irecv_state *state,
-                  detail::stl_container) const {
+      irequest irsend(const T &data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        irsend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
-      template<typename T, typename C>
-      irequest irsend(const T &data, int destination, tag_t t, C) const {
-        auto *request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto *send_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, destination, t, send_state]() {
-          irsend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<isend_task<value_type>>(MPI_Irsend, data, destination, t, comm_))};
       }
 
     public:
@@ -1650,8 +1951,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return irsend(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Irsend(&(*begin), distance_as_int(begin, end),
+                     detail::datatype_traits<value_type>::get_datatype(), destination,
+                     static_cast<int>(t), comm_, &req);
+          return base_irequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return irsend(&(*begin), l, destination, t);
@@ -1718,8 +2024,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return rsend_init(&(*begin), l, destination, t);
+          check_dest(destination);
+          check_send_tag(t);
+          MPI_Request req;
+          MPI_Rsend_init(&(*begin), distance_as_int(begin, end),
+                         detail::datatype_traits<value_type>::get_datatype(), destination,
+                         static_cast<int>(t), comm_, &req);
+          return base_prequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return rsend_init(&(*begin), l, destination, t);
@@ -1772,6 +2083,26 @@ namespace mpl {
         return s;
       }
 
+      template<typename T>
+      status_t recv(T &data, int source, tag_t t, detail::serialized_type) const {
+        status_t s;
+        auto *ps{static_cast<MPI_Status *>(&s)};
+        MPI_Message message;
+        MPI_Mprobe(source, static_cast<int>(t), comm_, &message, ps);
+        const bool no_proc{message == MPI_MESSAGE_NO_PROC};
+        int count{0};
+        MPI_Get_count(ps, MPI_BYTE, &count);
+        check_count(count);
+        detail::pooled_buffer buffer;
+        buffer.get().resize(count);
+        MPI_Mrecv(buffer.get().data(), count, MPI_BYTE, &message, ps);
+        if (not no_proc) {
+          input_archive ar(buffer.get().data(), count);
+          ar >> data;
+        }
+        return s;
+      }
+
     public:
       /// Receives a message with a single value.
       /// \tparam T type of the data to receive, must meet the requirements as described in the
@@ -1789,7 +2120,7 @@ namespace mpl {
       status_t recv(T &data, int source, tag_t t = tag_t{0}) const {
         check_source(source);
         check_recv_tag(t);
-        return recv(data, source, t, typename detail::datatype_traits<T>::data_type_category{});
+        return recv(data, source, t, detail::transfer_category_t<T>{});
       }
 
       /// Receives a message with several values having a specific memory layout.
@@ -1810,6 +2141,28 @@ namespace mpl {
         return s;
       }
 
+      /// Receives a packed message.  The buffer of the packed message is enlarged as required
+      /// to hold the incoming message and its previous content is replaced.
+      /// \param message packed message to receive, must have been created for this
+      /// communicator
+      /// \param source rank of the sending process
+      /// \param t tag associated to this message
+      /// \return status of the receive operation
+      /// \see \c packed_message
+      status_t recv(packed_message &message, int source, tag_t t = tag_t{0}) const {
+        check_source(source);
+        check_recv_tag(t);
+        status_t s;
+        auto *ps{static_cast<MPI_Status *>(&s)};
+        MPI_Message m;
+        MPI_Mprobe(source, static_cast<int>(t), comm_, &m, ps);
+        int count{0};
+        MPI_Get_count(ps, MPI_PACKED, &count);
+        check_count(count);
+        MPI_Mrecv(message.prepare_recv(count), count, MPI_PACKED, &m, ps);
+        return s;
+      }
+
       /// Receives a message with several values given by a pair of iterators.
       /// \tparam iterT iterator type, must fulfill the requirements of a
       /// <a
@@ -1829,8 +2182,13 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return recv(&(*begin), l, source, t);
+          check_source(source);
+          check_recv_tag(t);
+          status_t s;
+          MPI_Recv(&(*begin), distance_as_int(begin, end),
+                   detail::datatype_traits<value_type>::get_datatype(), source,
+                   static_cast<int>(t), comm_, static_cast<MPI_Status *>(&s));
+          return s;
         } else {
           const iterator_layout<value_type> l(begin, end);
           return recv(&(*begin), l, source, t);
@@ -1847,31 +2205,16 @@ namespace mpl {
         return base_irequest{req};
       }
 
-      template<typename T>
-      void irecv(T &data, int source, tag_t t, isend_irecv_state *state,
-                 detail::stl_container) const {
-        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        const status_t s{recv(data, source, t)};
-        state->request_state->source = s.source();
-        state->request_state->tag = static_cast<int>(s.tag());
-        state->request_state->datatype = detail::datatype_traits<value_type>::get_datatype();
-        state->request_state->count = s.get_count<value_type>();
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
       template<typename T, typename C>
       irequest irecv(T &data, int source, tag_t t, C) const {
-        auto *request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto *recv_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, source, t, recv_state]() {
-          irecv(data, source, t, recv_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<irecv_task<T, C>>(data, source, t, comm_))};
+      }
+
+      template<typename T>
+      irequest irecv(T &data, int source, tag_t t, detail::serialized_type) const {
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<serialized_irecv_task<T>>(data, source, t, comm_))};
       }
 
     public:
@@ -1886,12 +2229,14 @@ namespace mpl {
       /// \note Receiving STL containers is a convenience feature, which may have non-optimal
       /// performance characteristics. Use alternative overloads in performance-critical code
       /// sections.
+      /// \note Transfers of STL containers, which are not stored contiguously in memory, and
+      /// receive operations of STL containers are driven by MPL itself.  They make progress
+      /// whenever a request is tested or waited for via MPL.
       template<typename T>
       irequest irecv(T &data, int source, tag_t t = tag_t{0}) const {
         check_source(source);
         check_recv_tag(t);
-        return irecv(data, source, t,
-                     typename detail::datatype_traits<T>::data_type_category{});
+        return irecv(data, source, t, detail::transfer_category_t<T>{});
       }
 
       /// Receives a message with several values having a specific memory layout via a
@@ -1933,8 +2278,13 @@ namespace mpl {
         static_assert(std::is_lvalue_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return irecv(&(*begin), l, source, t);
+          check_source(source);
+          check_recv_tag(t);
+          MPI_Request req;
+          MPI_Irecv(&(*begin), distance_as_int(begin, end),
+                    detail::datatype_traits<value_type>::get_datatype(), source,
+                    static_cast<int>(t), comm_, &req);
+          return base_irequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return irecv(&(*begin), l, source, t);
@@ -1998,8 +2348,13 @@ namespace mpl {
       prequest recv_init(iterT begin, iterT end, int source, tag_t t = tag_t{0}) const {
         using value_type = typename std::iterator_traits<iterT>::value_type;
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return recv_init(&(*begin), l, source, t);
+          check_source(source);
+          check_recv_tag(t);
+          MPI_Request req;
+          MPI_Recv_init(&(*begin), distance_as_int(begin, end),
+                        detail::datatype_traits<value_type>::get_datatype(), source,
+                        static_cast<int>(t), comm_, &req);
+          return base_prequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return recv_init(&(*begin), l, source, t);
@@ -2132,8 +2487,11 @@ namespace mpl {
         static_assert(std::is_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return mrecv(&(*begin), l, m);
+          status_t s;
+          MPI_Mrecv(&(*begin), distance_as_int(begin, end),
+                    detail::datatype_traits<value_type>::get_datatype(), &m,
+                    static_cast<MPI_Status *>(&s));
+          return s;
         } else {
           const iterator_layout<value_type> l(begin, end);
           return mrecv(&(*begin), l, m);
@@ -2197,8 +2555,10 @@ namespace mpl {
         static_assert(std::is_lvalue_reference_v<decltype(*begin)>,
                       "iterator de-referencing must yield a reference");
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return imrecv(&(*begin), l, m);
+          MPI_Request req;
+          MPI_Imrecv(&(*begin), distance_as_int(begin, end),
+                     detail::datatype_traits<value_type>::get_datatype(), &m, &req);
+          return base_irequest{req};
         } else {
           const iterator_layout<value_type> l(begin, end);
           return imrecv(&(*begin), l, m);
@@ -2287,10 +2647,17 @@ namespace mpl {
         using value_type_2 = typename std::iterator_traits<iterT2>::value_type;
         if constexpr (detail::is_contiguous_iterator_v<iterT1> and
                       detail::is_contiguous_iterator_v<iterT2>) {
-          const vector_layout<value_type_1> l_1(std::distance(begin_1, end_1));
-          const vector_layout<value_type_2> l_2(std::distance(begin_2, end_2));
-          return sendrecv(&(*begin_1), l_1, destination, send_tag, &(*begin_2), l_2, source,
-                          recv_tag);
+          check_dest(destination);
+          check_source(source);
+          check_send_tag(send_tag);
+          check_recv_tag(recv_tag);
+          status_t s;
+          MPI_Sendrecv(&(*begin_1), distance_as_int(begin_1, end_1),
+                       detail::datatype_traits<value_type_1>::get_datatype(), destination,
+                       static_cast<int>(send_tag), &(*begin_2), distance_as_int(begin_2, end_2),
+                       detail::datatype_traits<value_type_2>::get_datatype(), source,
+                       static_cast<int>(recv_tag), comm_, static_cast<MPI_Status *>(&s));
+          return s;
         } else if constexpr (detail::is_contiguous_iterator_v<iterT1>) {
           const vector_layout<value_type_1> l_1(std::distance(begin_1, end_1));
           const iterator_layout<value_type_2> l_2(begin_2, end_2);
@@ -2376,8 +2743,16 @@ namespace mpl {
                                 int source, tag_t recvtag) const {
         using value_type = typename std::iterator_traits<iterT>::value_type;
         if constexpr (detail::is_contiguous_iterator_v<iterT>) {
-          const vector_layout<value_type> l(std::distance(begin, end));
-          return sendrecv_replace(&(*begin), l, destination, send_tag, source, recvtag);
+          check_dest(destination);
+          check_source(source);
+          check_send_tag(send_tag);
+          check_recv_tag(recvtag);
+          status_t s;
+          MPI_Sendrecv_replace(&(*begin), distance_as_int(begin, end),
+                               detail::datatype_traits<value_type>::get_datatype(), destination,
+                               static_cast<int>(send_tag), source, static_cast<int>(recvtag),
+                               comm_, static_cast<MPI_Status *>(&s));
+          return s;
         } else {
           const iterator_layout<value_type> l(begin, end);
           return sendrecv_replace(&(*begin), l, destination, send_tag, source, recvtag);
@@ -2405,74 +2780,486 @@ namespace mpl {
         return base_irequest{req};
       }
 
-      // === broadcast ===
-      // --- blocking broadcast ---
-      /// Broadcasts a message from a process to all other processes.
-      /// \tparam T type of the data to send, must meet the requirements as described in the
-      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
-      /// \param root_rank rank of the sending process
-      /// \param data buffer for sending/receiving data
-      /// \note This is a collective operation and must be called by all processes in the
-      /// communicator.
-      template<typename T>
-      void bcast(int root_rank, T &data) const {
-        check_root(root_rank);
-        MPI_Bcast(&data, 1, detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
-      }
+    protected:
+      // duplicate of the communicator that isolates the messages of collective operations
+      // that are implemented by point-to-point communication (sparse data exchanges and ring
+      // all-reduce operations) from all other messages, created on first use and cached as an
+      // attribute of the communicator
+      //
+      // Non-blocking collective operations on containers, which are composed of several MPI
+      // collective operations, start their later phases on the duplicate when the progress
+      // engine detects that the preceding phase has been completed.  This may happen in
+      // different orders on different processes.  MPI requires that all processes start
+      // collective operations on a communicator in the same order, which is enforced by
+      // tickets.  A ticket is drawn when a collective operation is called, i.e., in the same
+      // order on all processes, and an operation may start its collective operation on the
+      // duplicate only after all operations with earlier tickets have started theirs.
+      struct collective_context {
+        MPI_Comm comm{MPI_COMM_NULL};
+        int round{0};
+        std::uint64_t tickets_drawn{0};
+        std::uint64_t tickets_punched{0};
+
+        collective_context() = default;
+
+        collective_context(const collective_context &) = delete;
+
+        void operator=(const collective_context &) = delete;
+
+        ~collective_context() {
+          MPI_Comm_free(&comm);
+        }
+      };
 
-      /// Broadcasts a message from a process to all other processes.
-      /// \tparam T type of the data to send, must meet the requirements as described in the
-      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
-      /// \param root_rank rank of the sending process
-      /// \param data buffer for sending/receiving data
-      /// \param l memory layout of the data to send/receive
-      /// \note This is a collective operation and must be called by all processes in the
-      /// communicator.
-      template<typename T>
-      void bcast(int root_rank, T *data, const layout<T> &l) const {
-        check_root(root_rank);
-        MPI_Bcast(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), root_rank,
-                  comm_);
+      static int delete_collective_context(MPI_Comm, int, void *attribute, void *) {
+        delete static_cast<std::shared_ptr<collective_context> *>(attribute);
+        return MPI_SUCCESS;
       }
 
-      // --- non-blocking broadcast ---
-      /// Broadcasts a message from a process to all other processes in a non-blocking
-      /// manner.
-      /// \tparam T type of the data to send, must meet the requirements as described in the
-      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
-      /// \param root_rank rank of the sending process
-      /// \param data buffer for sending/receiving data
-      /// \return request representing the ongoing message transfer
-      /// \note This is a collective operation and must be called by all processes in the
-      /// communicator.
-      template<typename T>
-      irequest ibcast(int root_rank, T &data) const {
-        check_root(root_rank);
-        MPI_Request req;
-        MPI_Ibcast(&data, 1, detail::datatype_traits<T>::get_datatype(), root_rank, comm_,
-                   &req);
-        return base_irequest{req};
-      }
+      // the context is shared by the communicator and all pending operations that refer to it,
+      // such that the communicator may be freed while operations are pending
+      [[nodiscard]] const std::shared_ptr<collective_context> &get_shared_collective_context()
+          const {
+        static const int keyval{[]() {
+          int k;
+          MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, delete_collective_context, &k,
+                                 nullptr);
+          return k;
+        }()};
+        void *attribute;
+        int flag;
+        MPI_Comm_get_attr(comm_, keyval, &attribute, &flag);
+        if (flag != 0)
+          return *static_cast<std::shared_ptr<collective_context> *>(attribute);
+        auto *context{
+            new std::shared_ptr<collective_context>{std::make_shared<collective_context>()}};
+        MPI_Comm_dup(comm_, &(*context)->comm);
+        MPI_Comm_set_attr(comm_, keyval, context);
+        return *context;
+      }
+
+      [[nodiscard]] collective_context &get_collective_context() const {
+        return *get_shared_collective_context();
+      }
+
+      // ticket for starting a collective operation on the duplicate of a collective context
+      class collective_ticket {
+        std::shared_ptr<collective_context> context_;
+        std::uint64_t number_;
+
+      public:
+        explicit collective_ticket(std::shared_ptr<collective_context> context)
+            : context_{std::move(context)}, number_{context_->tickets_drawn++} {
+        }
 
-      /// Broadcasts a message from a process to all other processes in a non-blocking
-      /// manner.
-      /// \tparam T type of the data to send, must meet the requirements as described in the
-      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
-      /// \param root_rank rank of the sending process
-      /// \param data buffer for sending/receiving data
-      /// \param l memory layout of the data to send/receive
-      /// \return request representing the ongoing message transfer
-      /// \note This is a collective operation and must be called by all processes in the
-      /// communicator.
-      template<typename T>
-      irequest ibcast(int root_rank, T *data, const layout<T> &l) const {
-        check_root(root_rank);
+        [[nodiscard]] MPI_Comm comm() const {
+          return context_->comm;
+        }
+
+        // true if all operations with earlier tickets have started their collective operations
+        [[nodiscard]] bool is_due() const {
+          return context_->tickets_punched == number_;
+        }
+
+        // must be called when the collective operation has been started or if the operation
+        // does not need to start a collective operation on the duplicate
+        void punch() {
+          ++context_->tickets_punched;
+        }
+      };
+
+      // === broadcast ===
+      // STL containers are broadcast by a protocol that first broadcasts a message of fixed
+      // size, which holds the number of elements and, if they fit into this message, also the
+      // elements.  Elements of larger containers are broadcast subsequently in chunks by
+      // concurrent non-blocking broadcasts such that the transfer of the chunks is pipelined.
+      // Elements of contiguous resizable containers are received in place, elements of other
+      // containers into uninitialized memory.  On inter-communicators, processes of the root
+      // group that pass proc_null do not learn the size of the container.  Therefore, the
+      // elements are broadcast by a single broadcast on inter-communicators, which all
+      // processes join, possibly with zero elements.
+      static constexpr int container_bcast_header_size{1024};
+      static constexpr int container_bcast_chunk_size{1 << 20};
+
+      template<typename T>
+      class container_bcast {
+        static constexpr bool is_in_place{
+            std::is_base_of_v<detail::contiguous_const_stl_container,
+                              typename detail::datatype_traits<T>::data_type_category>};
+        using value_type =
+            std::conditional_t<is_in_place, typename T::value_type,
+                               detail::remove_const_from_members_t<typename T::value_type>>;
+
+        T &data_;
+        const int root_rank_;
+        const MPI_Comm comm_;
+        const bool is_root_;
+        bool is_inter_{false};
+        detail::vector<char> header_;
+        std::optional<detail::vector<value_type>> serial_data_;
+        value_type *payload_{nullptr};
+        int count_{0};
+        bool is_eager_{false};
+        std::vector<MPI_Request> requests_;
+
+        static MPI_Datatype datatype() {
+          return detail::datatype_traits<value_type>::get_datatype();
+        }
+
+      public:
+        container_bcast(int root_rank, T &data, MPI_Comm comm, bool is_root)
+            : data_{data},
+              root_rank_{root_rank},
+              comm_{comm},
+              is_root_{is_root},
+              header_(container_bcast_header_size, detail::uninitialized{}) {
+          int is_inter{0};
+          MPI_Comm_test_inter(comm_, &is_inter);
+          is_inter_ = is_inter != 0;
+          if (not is_root_)
+            return;
+          if constexpr (is_in_place)
+            payload_ = data_.size() > 0 ? &data_[0] : nullptr;
+          else {
+            serial_data_.emplace(data_.size(), std::begin(data_));
+            payload_ = serial_data_->data();
+          }
+          count_ = static_cast<int>(data_.size());
+          int header_size{0};
+          int payload_size{0};
+          MPI_Pack_size(2, MPI_INT, comm_, &header_size);
+          MPI_Pack_size(count_, datatype(), comm_, &payload_size);
+          is_eager_ = header_size + payload_size <= container_bcast_header_size;
+          const int header[2]{count_, is_eager_ ? 1 : 0};
+          int position{0};
+          MPI_Pack(header, 2, MPI_INT, header_.data(), container_bcast_header_size, &position,
+                   comm_);
+          if (is_eager_)
+            MPI_Pack(payload_, count_, datatype(), header_.data(), container_bcast_header_size,
+                     &position, comm_);
+        }
+
+        container_bcast(const container_bcast &) = delete;
+
+        void operator=(const container_bcast &) = delete;
+
+        [[nodiscard]] char *header() {
+          return header_.data();
+        }
+
+        // must be called after the header has been broadcast, prepares the storage for the
+        // elements on non-root processes and starts the broadcast of large payloads on the
+        // given communicator, which is either the communicator of the header or its duplicate
+        // must be called after the header has been broadcast, prepares the storage for the
+        // elements on non-root processes and starts the broadcast of large payloads
+        void start_payload(MPI_Comm payload_comm) {
+          if (root_rank_ == mpl::proc_null) {
+            requests_.push_back(MPI_REQUEST_NULL);
+            MPI_Ibcast(nullptr, 0, datatype(), root_rank_, payload_comm, &requests_.back());
+            return;
+          }
+          if (not is_root_) {
+            int header[2];
+            int position{0};
+            MPI_Unpack(header_.data(), container_bcast_header_size, &position, header, 2,
+                       MPI_INT, comm_);
+            count_ = header[0];
+            is_eager_ = header[1] != 0;
+            if constexpr (is_in_place) {
+              if constexpr (detail::has_resize_v<T>) {
+                if (static_cast<int>(data_.size()) != count_)
+                  data_.resize(count_);
+              } else {
+#if defined MPL_DEBUG
+                if (static_cast<int>(data_.size()) != count_)
+                  throw invalid_count();
+#endif
+              }
+              payload_ = data_.size() > 0 ? &data_[0] : nullptr;
+            } else {
+              serial_data_.emplace(count_, detail::uninitialized{});
+              payload_ = serial_data_->data();
+            }
+            if (is_eager_)
+              MPI_Unpack(header_.data(), container_bcast_header_size, &position, payload_,
+                         count_, datatype(), comm_);
+          }
+          if (is_inter_) {
+            requests_.push_back(MPI_REQUEST_NULL);
+            MPI_Ibcast(payload_, is_eager_ ? 0 : count_, datatype(), root_rank_, payload_comm,
+                       &requests_.back());
+            return;
+          }
+          if (is_eager_)
+            return;
+          const int chunk{std::max(1, container_bcast_chunk_size /
+                                          static_cast<int>(std::max<std::size_t>(
+                                              1, sizeof(value_type))))};
+          for (int first{0}; first < count_; first += chunk) {
+            requests_.push_back(MPI_REQUEST_NULL);
+            MPI_Ibcast(payload_ + first, std::min(chunk, count_ - first), datatype(),
+                       root_rank_, payload_comm, &requests_.back());
+          }
+        }
+
+        void wait_payload() {
+          MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(),
+                      MPI_STATUSES_IGNORE);
+        }
+
+        [[nodiscard]] bool test_payload() {
+          int flag{1};
+          MPI_Testall(static_cast<int>(requests_.size()), requests_.data(), &flag,
+                      MPI_STATUSES_IGNORE);
+          return flag != 0;
+        }
+
+        // must be called after the payload has been broadcast
+        void finish() {
+          if constexpr (not is_in_place)
+            if (not is_root_ and root_rank_ != mpl::proc_null) {
+              T new_data(serial_data_->begin(), serial_data_->end());
+              data_.swap(new_data);
+            }
+        }
+
+        [[nodiscard]] MPI_Status status() const {
+          MPI_Status s{};
+          s.MPI_SOURCE = root_rank_;
+          s.MPI_TAG = MPI_ANY_TAG;
+          MPI_Status_set_elements(&s, datatype(), count_);
+          return s;
+        }
+      };
+
+      template<typename T>
+      class ibcast_container_task final : public progress_task {
+        container_bcast<T> bcast_;
+        collective_ticket ticket_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool header_done_{false};
+        bool payload_started_{false};
+
+      public:
+        ibcast_container_task(int root_rank, T &data, MPI_Comm comm, bool is_root,
+                              collective_ticket ticket)
+            : bcast_{root_rank, data, comm, is_root}, ticket_{std::move(ticket)} {
+          MPI_Ibcast(bcast_.header(), container_bcast_header_size, MPI_PACKED, root_rank, comm,
+                     &req_);
+        }
+
+        bool progress() override {
+          if (not header_done_) {
+            int flag;
+            MPI_Test(&req_, &flag, MPI_STATUS_IGNORE);
+            if (flag == 0)
+              return false;
+            header_done_ = true;
+          }
+          if (not payload_started_) {
+            if (not ticket_.is_due())
+              return false;
+            bcast_.start_payload(ticket_.comm());
+            ticket_.punch();
+            payload_started_ = true;
+          }
+          if (not bcast_.test_payload())
+            return false;
+          bcast_.finish();
+          complete(bcast_.status());
+          return true;
+        }
+      };
+
+      // true if the calling process provides the data of a broadcast
+      [[nodiscard]] bool is_bcast_root(int root_rank) const {
+        int is_inter{0};
+        MPI_Comm_test_inter(comm_, &is_inter);
+        return is_inter != 0 ? root_rank == mpl::root : root_rank == rank();
+      }
+
+    private:
+      template<typename T>
+      void bcast(int root_rank, T &data, detail::basic_or_fixed_size_type) const {
+        MPI_Bcast(&data, 1, detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+      }
+
+      template<typename T>
+      void bcast(int root_rank, T &data, detail::stl_container) const {
+        if (is_bcast_root(root_rank))
+          check_container_size(data);
+        container_bcast<T> bcast(root_rank, data, comm_, is_bcast_root(root_rank));
+        MPI_Bcast(bcast.header(), container_bcast_header_size, MPI_PACKED, root_rank, comm_);
+        bcast.start_payload(comm_);
+        bcast.wait_payload();
+        bcast.finish();
+      }
+
+      // serialized data is broadcast as its size followed by the serialized bytes
+      template<typename T>
+      void bcast(int root_rank, T &data, detail::serialized_type) const {
+        const bool is_root{is_bcast_root(root_rank)};
+        detail::pooled_buffer buffer;
+        std::uint64_t size{0};
+        if (is_root) {
+          output_archive ar(buffer.get());
+          ar << data;
+          size = ar.size();
+#if defined MPL_DEBUG
+          if (size > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+            throw invalid_count();
+#endif
+        }
+        MPI_Bcast(&size, 1, MPI_UINT64_T, root_rank, comm_);
+        if (not is_root)
+          buffer.get().resize(size);
+        MPI_Bcast(buffer.get().data(), static_cast<int>(size), MPI_BYTE, root_rank, comm_);
+        if (not is_root and root_rank != mpl::proc_null) {
+          input_archive ar(buffer.get().data(), size);
+          ar >> data;
+        }
+      }
+
+      template<typename T>
+      irequest ibcast(int root_rank, T &data, detail::basic_or_fixed_size_type) const {
+        MPI_Request req;
+        MPI_Ibcast(&data, 1, detail::datatype_traits<T>::get_datatype(), root_rank, comm_,
+                   &req);
+        return base_irequest{req};
+      }
+
+      template<typename T>
+      irequest ibcast(int root_rank, T &data, detail::stl_container) const {
+        if (is_bcast_root(root_rank))
+          check_container_size(data);
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<ibcast_container_task<T>>(
+                root_rank, data, comm_, is_bcast_root(root_rank),
+                collective_ticket{get_shared_collective_context()}))};
+      }
+
+    public:
+      // --- blocking broadcast ---
+      /// Broadcasts a message from a process to all other processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section or an STL container
+      /// that holds elements that comply with the mentioned requirements
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  STL containers are resized on non-root processes as required.  Small
+      /// containers are broadcast by a single message, larger containers are broadcast in
+      /// pipelined chunks.  Broadcasting STL containers over an inter-communicator is not
+      /// supported.
+      template<typename T>
+      void bcast(int root_rank, T &data) const {
+        check_root(root_rank);
+        bcast(root_rank, data, detail::transfer_category_t<T>{});
+      }
+
+      /// Broadcasts a message from a process to all other processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \param l memory layout of the data to send/receive
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.
+      template<typename T>
+      void bcast(int root_rank, T *data, const layout<T> &l) const {
+        check_root(root_rank);
+        MPI_Bcast(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), root_rank,
+                  comm_);
+      }
+
+      // --- non-blocking broadcast ---
+      /// Broadcasts a message from a process to all other processes in a non-blocking
+      /// manner.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section or an STL container
+      /// that holds elements that comply with the mentioned requirements
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \return request representing the ongoing message transfer
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  STL containers are resized on non-root processes as required.
+      template<typename T>
+      irequest ibcast(int root_rank, T &data) const {
+        check_root(root_rank);
+        return ibcast(root_rank, data,
+                      typename detail::datatype_traits<T>::data_type_category{});
+      }
+
+      /// Broadcasts a message from a process to all other processes in a non-blocking
+      /// manner.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \param l memory layout of the data to send/receive
+      /// \return request representing the ongoing message transfer
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.
+      template<typename T>
+      irequest ibcast(int root_rank, T *data, const layout<T> &l) const {
+        check_root(root_rank);
         MPI_Request req;
         MPI_Ibcast(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), root_rank,
                    comm_, &req);
         return base_irequest{req};
       }
 
+      // --- persistent broadcast ---
+      /// Creates a persistent request for broadcasting a message from a process to all other
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section, STL containers are
+      /// not supported
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \return persistent request, the broadcast is carried out each time the request is
+      /// started
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  The request must be started by all processes in the same order as
+      /// other collective operations.  The broadcast is always emulated by a non-blocking
+      /// broadcast, which is started each time the request is started.
+      template<typename T>
+      prequest bcast_init(int root_rank, T &data) const {
+        static_assert(std::is_same_v<typename detail::datatype_traits<T>::data_type_category,
+                                     detail::basic_or_fixed_size_type>,
+                      "persistent broadcast of STL containers is not supported");
+        check_root(root_rank);
+        const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+        return emulated_prequest([data = &data, datatype, root_rank, comm = comm_]() {
+          MPI_Request req;
+          MPI_Ibcast(data, 1, datatype, root_rank, comm, &req);
+          return req;
+        });
+      }
+
+      /// Creates a persistent request for broadcasting a message from a process to all other
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \param l memory layout of the data to send/receive
+      /// \return persistent request, the broadcast is carried out each time the request is
+      /// started
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  The request must be started by all processes in the same order as
+      /// other collective operations.
+      template<typename T>
+      prequest bcast_init(int root_rank, T *data, const layout<T> &l) const {
+        check_root(root_rank);
+        return emulated_prequest([data, l, root_rank, comm = comm_]() {
+          MPI_Request req;
+          MPI_Ibcast(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), root_rank,
+                     comm, &req);
+          return req;
+        });
+      }
+
       // === gather ===
       // === root gets a single value from each rank and stores in contiguous memory
       // --- blocking gather ---
@@ -2868,6 +3655,120 @@ namespace mpl {
         return base_irequest{req};
       }
 
+      // --- gather of containers ---
+    protected:
+      // displacements of blocks given by offsets as in the compressed sparse row format in
+      // units of elements
+      static std::vector<int> offsets_as_displacements(
+          const std::vector<std::size_t> &offsets) {
+        std::vector<int> displs;
+        displs.reserve(offsets.size() - 1);
+        for (std::size_t i{0}; i + 1 < offsets.size(); ++i) {
+#if defined MPL_DEBUG
+          if (offsets[i] > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            throw invalid_count();
+#endif
+          displs.push_back(static_cast<int>(offsets[i]));
+        }
+        return displs;
+      }
+
+      // numbers of elements of blocks given by offsets as in the compressed sparse row format
+      static std::vector<int> offsets_as_counts(const std::vector<std::size_t> &offsets) {
+        std::vector<int> counts;
+        counts.reserve(offsets.size() - 1);
+        for (std::size_t i{0}; i + 1 < offsets.size(); ++i) {
+#if defined MPL_DEBUG
+          if (offsets[i + 1] < offsets[i] or
+              offsets[i + 1] - offsets[i] >
+                  static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            throw invalid_count();
+#endif
+          counts.push_back(static_cast<int>(offsets[i + 1] - offsets[i]));
+        }
+        return counts;
+      }
+
+      // displacements of the blocks of a csr_vector in units of elements
+      template<typename T>
+      static std::vector<int> csr_displacements(const csr_vector<T> &v) {
+        return offsets_as_displacements(v.offsets());
+      }
+
+      // non-blocking (all-)gather of containers, gathers the numbers of elements first and
+      // the elements when the numbers of elements are known
+      template<typename T>
+      class igatherv_container_task final : public progress_task {
+        const T *send_data_;
+        int count_;
+        csr_vector<T> *recv_data_;
+        const std::optional<int> root_rank_;
+        const MPI_Comm comm_;
+        collective_ticket ticket_;
+        std::vector<int> counts_;
+        std::vector<int> displs_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool counts_done_{false};
+        bool elements_started_{false};
+
+      public:
+        // root_rank is empty for all-gather operations, recv_data is a null pointer on
+        // non-root processes, the elements are gathered on the communicator of the ticket
+        igatherv_container_task(const T *send_data, int count, csr_vector<T> *recv_data,
+                                std::optional<int> root_rank, int size, MPI_Comm comm,
+                                collective_ticket ticket)
+            : send_data_{send_data},
+              count_{count},
+              recv_data_{recv_data},
+              root_rank_{root_rank},
+              comm_{comm},
+              ticket_{std::move(ticket)},
+              counts_(recv_data != nullptr ? size : 0) {
+          if (not root_rank_)
+            MPI_Iallgather(&count_, 1, MPI_INT, counts_.data(), 1, MPI_INT, comm_, &req_);
+          else
+            MPI_Igather(&count_, 1, MPI_INT, counts_.data(), 1, MPI_INT, *root_rank_, comm_,
+                        &req_);
+        }
+
+        bool progress() override {
+          if (not counts_done_) {
+            int flag;
+            MPI_Test(&req_, &flag, MPI_STATUS_IGNORE);
+            if (flag == 0)
+              return false;
+            counts_done_ = true;
+          }
+          if (not elements_started_) {
+            if (not ticket_.is_due())
+              return false;
+            T *recv_buffer{nullptr};
+            if (recv_data_ != nullptr) {
+              recv_data_->assign_counts(counts_.data(), static_cast<int>(counts_.size()));
+              displs_ = csr_displacements(*recv_data_);
+              recv_buffer = recv_data_->values().data();
+            }
+            const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+            if (not root_rank_)
+              MPI_Iallgatherv(send_data_, count_, datatype, recv_buffer, counts_.data(),
+                              displs_.data(), datatype, ticket_.comm(), &req_);
+            else
+              MPI_Igatherv(send_data_, count_, datatype, recv_buffer, counts_.data(),
+                           displs_.data(), datatype, *root_rank_, ticket_.comm(), &req_);
+            ticket_.punch();
+            elements_started_ = true;
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          complete(s);
+          return true;
+        }
+      };
+
+    public:
       // === allgather ===
       // === get a single value from each rank and stores in contiguous memory
       // --- blocking allgather ---
@@ -2940,6 +3841,54 @@ namespace mpl {
         return base_irequest{req};
       }
 
+      // --- persistent allgather ---
+      /// Creates a persistent request for gathering messages from all processes and
+      /// distributing the result to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \return persistent request, the operation is carried out each time the request is
+      /// started
+      /// \note This is a collective operation and must be called (possibly by utilizing
+      /// another overload) by all processes in the communicator.  The request must be started
+      /// by all processes in the same order as other collective operations.
+      template<typename T>
+      prequest allgather_init(const T &send_data, T *recv_data) const {
+        const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+        return emulated_prequest(
+            [send_data = &send_data, recv_data, datatype, comm = comm_]() {
+              MPI_Request req;
+              MPI_Iallgather(send_data, 1, datatype, recv_data, 1, datatype, comm, &req);
+              return req;
+            });
+      }
+
+      /// Creates a persistent request for gathering messages from all processes and
+      /// distributing the result to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data data to send
+      /// \param sendl memory layout of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvl memory layout of the data to receive
+      /// \return persistent request, the operation is carried out each time the request is
+      /// started
+      /// \note This is a collective operation and must be called (possibly by utilizing
+      /// another overload) by all processes in the communicator.  The request must be started
+      /// by all processes in the same order as other collective operations.
+      template<typename T>
+      prequest allgather_init(const T *send_data, const layout<T> &sendl, T *recv_data,
+                              const layout<T> &recvl) const {
+        return emulated_prequest([send_data, sendl, recv_data, recvl, comm = comm_]() {
+          MPI_Request req;
+          MPI_Iallgather(send_data, 1, detail::datatype_traits<layout<T>>::get_datatype(sendl),
+                         recv_data, 1, detail::datatype_traits<layout<T>>::get_datatype(recvl),
+                         comm, &req);
+          return req;
+        });
+      }
+
       // === get varying amount of data from each rank and stores in non-contiguous memory
       // --- blocking allgather ---
       /// Gather messages with a variable amount of data from all processes and
@@ -3597,13 +4546,10 @@ namespace mpl {
         const std::vector<int> counts(recvls.size(), 1);
         const auto senddispls_int{byte_displacements_as_vector_of_ints(senddispls)};
         const auto recvdispls_int{byte_displacements_as_vector_of_ints(recvdispls)};
-        static_assert(
-            sizeof(decltype(*sendls())) == sizeof(MPI_Datatype),
-            "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-        MPI_Alltoallw(send_data, counts.data(), senddispls_int.data(),
-                      reinterpret_cast<const MPI_Datatype *>(sendls()), recv_data,
-                      counts.data(), recvdispls_int.data(),
-                      reinterpret_cast<const MPI_Datatype *>(recvls()), comm_);
+        const auto sendtypes{sendls.datatypes()};
+        const auto recvtypes{recvls.datatypes()};
+        MPI_Alltoallw(send_data, counts.data(), senddispls_int.data(), sendtypes.data(),
+                      recv_data, counts.data(), recvdispls_int.data(), recvtypes.data(), comm_);
       }
 
       /// Sends messages with a variable amount of data to all processes and receives
@@ -3676,80 +4622,53 @@ namespace mpl {
 
       // --- non-blocking all-to-all ---
     protected:
-      struct ialltoallv_request_state {
-        MPI_Status status{};
-      };
+      // non-blocking all-to-all with individual data types per process, the task owns the
+      // count and displacement arrays until the operation has completed, copies of the data
+      // type handles are sufficient as freeing a data type does not affect pending operations
+      class ialltoallw_task final : public progress_task {
+        std::vector<int> counts_;
+        std::vector<int> senddispls_;
+        std::vector<MPI_Datatype> sendtypes_;
+        std::vector<int> recvdispls_;
+        std::vector<MPI_Datatype> recvtypes_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+
+      public:
+        template<typename T>
+        ialltoallw_task(const T *send_data, const layouts<T> &sendls,
+                        std::vector<int> &&senddispls, T *recv_data, const layouts<T> &recvls,
+                        std::vector<int> &&recvdispls, MPI_Comm comm)
+            : counts_(recvls.size(), 1),
+              senddispls_{std::move(senddispls)},
+              sendtypes_{sendls.datatypes()},
+              recvdispls_{std::move(recvdispls)},
+              recvtypes_{recvls.datatypes()} {
+          MPI_Ialltoallw(send_data, counts_.data(), senddispls_.data(), sendtypes_.data(),
+                         recv_data, counts_.data(), recvdispls_.data(), recvtypes_.data(), comm,
+                         &req_);
+        }
 
-      template<typename T>
-      struct ialltoallv_state {
-        MPI_Request req{};
-        layouts<T> sendl;
-        layouts<T> recvl;
-        std::vector<int> counts;
-        std::vector<int> senddispls_int;
-        std::vector<int> recvdispls_int;
-        ialltoallv_request_state *request_state{nullptr};
-
-        ialltoallv_state(const layouts<T> &sendl, const layouts<T> &recvl,
-                         std::vector<int> &&counts, std::vector<int> &&senddispls_int,
-                         std::vector<int> &&recvdispls_int)
-            : sendl{sendl},
-              recvl{recvl},
-              counts{std::move(counts)},
-              senddispls_int{std::move(senddispls_int)},
-              recvdispls_int{std::move(recvdispls_int)} {
+        template<typename T>
+        ialltoallw_task(T *sendrecv_data, const layouts<T> &sendrecvls,
+                        std::vector<int> &&sendrecvdispls, MPI_Comm comm)
+            : counts_(sendrecvls.size(), 1),
+              recvdispls_{std::move(sendrecvdispls)},
+              recvtypes_{sendrecvls.datatypes()} {
+          MPI_Ialltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, sendrecv_data, counts_.data(),
+                         recvdispls_.data(), recvtypes_.data(), comm, &req_);
         }
-        ialltoallv_state(const layouts<T> &recvl, std::vector<int> &&counts,
-                         std::vector<int> &&recvdispls_int)
-            : sendl{},
-              recvl{recvl},
-              counts{std::move(counts)},
-              senddispls_int{},
-              recvdispls_int{std::move(recvdispls_int)} {
+
+        bool progress() override {
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          complete(s);
+          return true;
         }
       };
 
-      static int ialltoallv_query(void *state, MPI_Status *s) {
-        auto *request_state{static_cast<ialltoallv_request_state *>(state)};
-        const int error_backup{s->MPI_ERROR};
-        *s = request_state->status;
-        s->MPI_ERROR = error_backup;
-        return MPI_SUCCESS;
-      }
-
-      static int ialltoallv_free(void *state) {
-        auto *request_state{static_cast<ialltoallv_request_state *>(state)};
-        delete request_state;
-        return MPI_SUCCESS;
-      }
-
-      static int ialltoallv_cancel([[maybe_unused]] void *state,
-                                   [[maybe_unused]] int complete) {
-        return MPI_SUCCESS;
-      }
-
-      template<typename T>
-      void ialltoallv_task(const T *send_data, T *recv_data, ialltoallv_state<T> *state) const {
-        MPI_Request req;
-        static_assert(
-            sizeof(decltype(*state->sendl())) == sizeof(MPI_Datatype),
-            "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-        if (send_data != nullptr)
-          MPI_Ialltoallw(send_data, state->counts.data(), state->senddispls_int.data(),
-                         reinterpret_cast<const MPI_Datatype *>(state->sendl()), recv_data,
-                         state->counts.data(), state->recvdispls_int.data(),
-                         reinterpret_cast<const MPI_Datatype *>(state->recvl()), comm_, &req);
-        else
-          MPI_Ialltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, recv_data,
-                         state->counts.data(), state->recvdispls_int.data(),
-                         reinterpret_cast<const MPI_Datatype *>(state->recvl()), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->status = s;
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
     public:
       /// Sends messages with a variable amount of data to all processes and receives
       /// messages with a variable amount of data from all processes in a non-blocking manner.
@@ -3781,21 +4700,9 @@ namespace mpl {
         check_size(sendls);
         check_size(recvdispls);
         check_size(recvls);
-        auto *request_state{new ialltoallv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(ialltoallv_query, ialltoallv_free, ialltoallv_cancel, request_state,
-                           &req);
-        auto *alltoall_state{
-            new ialltoallv_state<T>(sendls, recvls, std::vector<int>(recvls.size(), 1),
-                                    std::vector<int>(senddispls.begin(), senddispls.end()),
-                                    std::vector<int>(recvdispls.begin(), recvdispls.end()))};
-        alltoall_state->req = req;
-        alltoall_state->request_state = request_state;
-        std::thread thread([this, send_data, recv_data, alltoall_state]() {
-          ialltoallv_task(send_data, recv_data, alltoall_state);
-        });
-        thread.detach();
-        return base_irequest{req};
+        return base_irequest{get_progress_engine().start(std::make_unique<ialltoallw_task>(
+            send_data, sendls, byte_displacements_as_vector_of_ints(senddispls), recv_data,
+            recvls, byte_displacements_as_vector_of_ints(recvdispls), comm_))};
       }
 
       /// Sends messages with a variable amount of data to all processes and receives
@@ -3870,6 +4777,375 @@ namespace mpl {
         return ialltoallv(send_data, sendls, sendrecvdispls, recv_data, recvls, sendrecvdispls);
       }
 
+      // --- persistent all-to-all ---
+      /// Creates a persistent request for sending messages with a variable amount of data to
+      /// all processes and receiving messages with a variable amount of data from all
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param sendls memory layouts of the data to send
+      /// \param senddispls displacements of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive
+      /// \param recvdispls displacements of the data to receive
+      /// \return persistent request, the operation is carried out each time the request is
+      /// started
+      /// \details See \ref alltoallv for the meaning of the arguments.  Layouts and
+      /// displacements are stored by the request and may be destroyed after the function
+      /// has returned.
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.  The request must be started by all
+      /// processes in the same order as other collective operations.
+      template<typename T>
+      prequest alltoallv_init(const T *send_data, const layouts<T> &sendls,
+                              const displacements &senddispls, T *recv_data,
+                              const layouts<T> &recvls, const displacements &recvdispls) const {
+        check_size(senddispls);
+        check_size(sendls);
+        check_size(recvdispls);
+        check_size(recvls);
+        alltoallw_arguments<T> args(sendls, byte_displacements_as_vector_of_ints(senddispls),
+                                    recvls, byte_displacements_as_vector_of_ints(recvdispls));
+        return emulated_prequest(
+            [send_data, recv_data, a = std::move(args), comm = comm_]() {
+              MPI_Request req;
+              MPI_Ialltoallw(send_data, a.counts.data(), a.senddispls.data(),
+                             a.sendtypes.data(), recv_data, a.counts.data(),
+                             a.recvdispls.data(), a.recvtypes.data(), comm, &req);
+              return req;
+            });
+      }
+
+      /// Creates a persistent request for sending messages with a variable amount of data to
+      /// all processes and receiving messages with a variable amount of data from all
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param sendls memory layouts of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive
+      /// \return persistent request, the operation is carried out each time the request is
+      /// started
+      /// \details See \ref alltoallv for the meaning of the arguments.
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.  The request must be started by all
+      /// processes in the same order as other collective operations.
+      template<typename T>
+      prequest alltoallv_init(const T *send_data, const layouts<T> &sendls, T *recv_data,
+                              const layouts<T> &recvls) const {
+        const displacements sendrecvdispls(size());
+        return alltoallv_init(send_data, sendls, sendrecvdispls, recv_data, recvls,
+                              sendrecvdispls);
+      }
+
+      // --- all-to-all of containers ---
+    protected:
+      void check_alltoall_size([[maybe_unused]] std::size_t n) const {
+#if defined MPL_DEBUG
+        int is_inter{0};
+        MPI_Comm_test_inter(comm_, &is_inter);
+        int peers;
+        if (is_inter != 0)
+          MPI_Comm_remote_size(comm_, &peers);
+        else
+          MPI_Comm_size(comm_, &peers);
+        if (n != static_cast<std::size_t>(peers))
+          throw invalid_size();
+#endif
+      }
+
+      // copies containers into consecutive blocks of a csr_vector
+      template<typename T, typename A>
+      csr_vector<T> containers_as_csr_vector(const std::vector<std::vector<T, A>> &data) const {
+        std::vector<int> counts;
+        counts.reserve(data.size());
+        for (const auto &block : data) {
+          check_container_size(block);
+          counts.push_back(static_cast<int>(block.size()));
+        }
+        csr_vector<T> v;
+        v.assign_counts(counts.data(), static_cast<int>(counts.size()));
+        for (std::size_t i{0}; i < data.size(); ++i)
+          std::copy(data[i].begin(), data[i].end(), v.begin(i));
+        return v;
+      }
+
+      // non-blocking all-to-all of blocks of varying size, exchanges the numbers of elements
+      // first and the elements when the numbers of elements are known
+      template<typename T>
+      class ialltoallv_container_task final : public progress_task {
+        const csr_vector<T> send_buffer_;
+        const T *send_data_;
+        const std::vector<int> send_counts_;
+        const std::vector<int> send_displs_;
+        csr_vector<T> &recv_data_;
+        const MPI_Comm comm_;
+        collective_ticket ticket_;
+        std::vector<int> recv_counts_;
+        std::vector<int> recv_displs_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        bool counts_done_{false};
+        bool elements_started_{false};
+
+        void start() {
+          recv_counts_.resize(send_counts_.size());
+          MPI_Ialltoall(send_counts_.data(), 1, MPI_INT, recv_counts_.data(), 1, MPI_INT, comm_,
+                        &req_);
+        }
+
+      public:
+        // sends the blocks of a contiguous buffer, which must remain valid until completion,
+        // the elements are exchanged on the communicator of the ticket
+        ialltoallv_container_task(const T *send_data, const std::vector<std::size_t> &offsets,
+                                  csr_vector<T> &recv_data, MPI_Comm comm,
+                                  collective_ticket ticket)
+            : send_data_{send_data},
+              send_counts_{offsets_as_counts(offsets)},
+              send_displs_{offsets_as_displacements(offsets)},
+              recv_data_{recv_data},
+              comm_{comm},
+              ticket_{std::move(ticket)} {
+          start();
+        }
+
+        // sends the blocks of a csr_vector, which is owned by the task
+        ialltoallv_container_task(csr_vector<T> send_data, csr_vector<T> &recv_data,
+                                  MPI_Comm comm, collective_ticket ticket)
+            : send_buffer_{std::move(send_data)},
+              send_data_{send_buffer_.values().data()},
+              send_counts_{offsets_as_counts(send_buffer_.offsets())},
+              send_displs_{offsets_as_displacements(send_buffer_.offsets())},
+              recv_data_{recv_data},
+              comm_{comm},
+              ticket_{std::move(ticket)} {
+          start();
+        }
+
+        bool progress() override {
+          if (not counts_done_) {
+            int flag;
+            MPI_Test(&req_, &flag, MPI_STATUS_IGNORE);
+            if (flag == 0)
+              return false;
+            counts_done_ = true;
+          }
+          if (not elements_started_) {
+            if (not ticket_.is_due())
+              return false;
+            recv_data_.assign_counts(recv_counts_.data(),
+                                     static_cast<int>(recv_counts_.size()));
+            recv_displs_ = csr_displacements(recv_data_);
+            const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+            MPI_Ialltoallv(send_data_, send_counts_.data(), send_displs_.data(), datatype,
+                           recv_data_.values().data(), recv_counts_.data(),
+                           recv_displs_.data(), datatype, ticket_.comm(), &req_);
+            ticket_.punch();
+            elements_started_ = true;
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          complete(s);
+          return true;
+        }
+      };
+
+    private:
+      template<typename T>
+      void alltoallv_blocks(const T *send_data, const std::vector<std::size_t> &offsets,
+                            csr_vector<T> &recv_data) const {
+        const auto sendcounts{offsets_as_counts(offsets)};
+        const auto senddispls{offsets_as_displacements(offsets)};
+        std::vector<int> recvcounts(sendcounts.size());
+        MPI_Alltoall(sendcounts.data(), 1, MPI_INT, recvcounts.data(), 1, MPI_INT, comm_);
+        recv_data.assign_counts(recvcounts.data(), static_cast<int>(recvcounts.size()));
+        const auto recvdispls{csr_displacements(recv_data)};
+        MPI_Alltoallv(send_data, sendcounts.data(), senddispls.data(),
+                      detail::datatype_traits<T>::get_datatype(), recv_data.values().data(),
+                      recvcounts.data(), recvdispls.data(),
+                      detail::datatype_traits<T>::get_datatype(), comm_);
+      }
+
+    public:
+      /// Sends containers of varying size to all processes and receives containers of varying
+      /// size from all processes.  The numbers of elements are exchanged internally.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam A allocator type
+      /// \param send_data data to send, the i-th container is sent to the i-th process, must
+      /// hold one container for each process
+      /// \param recv_data will hold the received data, the i-th block holds the data of the
+      /// i-th process
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename A>
+      void alltoallv(const std::vector<std::vector<T, A>> &send_data,
+                     csr_vector<T> &recv_data) const {
+        check_alltoall_size(send_data.size());
+        const csr_vector<T> send_buffer{containers_as_csr_vector(send_data)};
+        alltoallv_blocks(send_buffer.values().data(), send_buffer.offsets(), recv_data);
+      }
+
+      /// Sends blocks of varying size to all processes and receives blocks of varying size
+      /// from all processes.  The numbers of elements are exchanged internally.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam A allocator type
+      /// \param send_data data to send
+      /// \param send_offsets offsets of the blocks in \c send_data as in the compressed sparse
+      /// row format, the elements with indices <tt>send_offsets[i]</tt> to
+      /// <tt>send_offsets[i + 1] - 1</tt> are sent to the i-th process, must hold one more
+      /// element than there are processes
+      /// \param recv_data will hold the received data, the i-th block holds the data of the
+      /// i-th process
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename A>
+      void alltoallv(const std::vector<T, A> &send_data,
+                     const std::vector<std::size_t> &send_offsets,
+                     csr_vector<T> &recv_data) const {
+        check_alltoall_size(send_offsets.size() - 1);
+        alltoallv_blocks(send_data.data(), send_offsets, recv_data);
+      }
+
+      /// Sends containers of varying size to all processes and receives containers of varying
+      /// size from all processes in a non-blocking manner.  The numbers of elements are
+      /// exchanged internally.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam A allocator type
+      /// \param send_data data to send, the i-th container is sent to the i-th process, must
+      /// hold one container for each process, is copied and may be modified after the function
+      /// has returned
+      /// \param recv_data will hold the received data, the i-th block holds the data of the
+      /// i-th process
+      /// \return request representing the ongoing message transfer
+      /// \details The exchange of the numbers of elements progresses while the calling process
+      /// carries out other work.
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename A>
+      irequest ialltoallv(const std::vector<std::vector<T, A>> &send_data,
+                          csr_vector<T> &recv_data) const {
+        check_alltoall_size(send_data.size());
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<ialltoallv_container_task<T>>(
+                containers_as_csr_vector(send_data), recv_data, comm_,
+                collective_ticket{get_shared_collective_context()}))};
+      }
+
+      /// Sends blocks of varying size to all processes and receives blocks of varying size
+      /// from all processes in a non-blocking manner.  The numbers of elements are exchanged
+      /// internally.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam A allocator type
+      /// \param send_data data to send, must not be modified until the operation has completed
+      /// \param send_offsets offsets of the blocks in \c send_data as in the compressed sparse
+      /// row format, the elements with indices <tt>send_offsets[i]</tt> to
+      /// <tt>send_offsets[i + 1] - 1</tt> are sent to the i-th process, must hold one more
+      /// element than there are processes
+      /// \param recv_data will hold the received data, the i-th block holds the data of the
+      /// i-th process
+      /// \return request representing the ongoing message transfer
+      /// \details The exchange of the numbers of elements progresses while the calling process
+      /// carries out other work.
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename A>
+      irequest ialltoallv(const std::vector<T, A> &send_data,
+                          const std::vector<std::size_t> &send_offsets,
+                          csr_vector<T> &recv_data) const {
+        check_alltoall_size(send_offsets.size() - 1);
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<ialltoallv_container_task<T>>(
+                send_data.data(), send_offsets, recv_data, comm_,
+                collective_ticket{get_shared_collective_context()}))};
+      }
+
+      // === sparse data exchange ===
+    public:
+      /// Exchanges messages of variable size with a set of processes, which is not known to
+      /// the receiving processes in advance.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam A allocator type of the vectors holding the data
+      /// \param send_data maps ranks of destination processes to the data that is sent to the
+      /// respective process
+      /// \param recv_data will map the ranks of all processes that sent data to this process to
+      /// the received data, previous content is discarded
+      /// \details Each process sends a message to each process whose rank is a key of
+      /// \c send_data, possibly including itself.  Messages are also sent if the data is empty.
+      /// In contrast to \ref alltoallv, a process does not need to know which processes send
+      /// data to it.  The operation implements the non-blocking consensus algorithm (NBX) by
+      /// Hoefler, Siebert, and Lumsdaine: Messages are sent by synchronous sends, incoming
+      /// messages are received by matching probes, and a non-blocking barrier is entered as
+      /// soon as all outgoing messages have been received by their destinations.  The
+      /// operation is completed when the barrier completes.  Memory usage and run time scale
+      /// with the number of communication partners rather than with the size of the
+      /// communicator.  Messages are sent via an internal duplicate of the communicator, which
+      /// is created when the function is called on the communicator for the first time.
+      /// Thus, messages of sparse data exchanges do not interfere with other messages.
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.
+      template<typename T, typename A>
+      void sparse_exchange(const std::map<int, std::vector<T, A>> &send_data,
+                           std::map<int, std::vector<T, A>> &recv_data) const {
+        collective_context &context{get_collective_context()};
+        collective_ticket ticket{get_shared_collective_context()};
+        // a process may receive messages of the next exchange before it has noticed the
+        // completion of the barrier, consecutive exchanges use different tags
+        const int tag{context.round};
+        context.round = 1 - context.round;
+        const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+        std::vector<MPI_Request> send_requests;
+        send_requests.reserve(send_data.size());
+        for (const auto &[destination, data] : send_data) {
+          check_dest(destination);
+          check_container_size(data);
+          MPI_Request req;
+          MPI_Issend(data.data(), static_cast<int>(data.size()), datatype, destination, tag,
+                     context.comm, &req);
+          send_requests.push_back(req);
+        }
+        recv_data.clear();
+        MPI_Request barrier_request{MPI_REQUEST_NULL};
+        bool barrier_entered{false};
+        while (true) {
+          int flag;
+          MPI_Message message;
+          MPI_Status s;
+          MPI_Improbe(MPI_ANY_SOURCE, tag, context.comm, &flag, &message, &s);
+          if (flag != 0) {
+            int count;
+            MPI_Get_count(&s, datatype, &count);
+            check_count(count);
+            auto &data{recv_data[s.MPI_SOURCE]};
+            data.resize(count);
+            MPI_Mrecv(data.data(), count, datatype, &message, MPI_STATUS_IGNORE);
+          } else if (barrier_entered) {
+            MPI_Test(&barrier_request, &flag, MPI_STATUS_IGNORE);
+            if (flag != 0)
+              break;
+          } else if (not ticket.is_due()) {
+            // pending non-blocking operations must start their collective operations first
+            get_progress_engine().progress();
+          } else {
+            MPI_Testall(static_cast<int>(send_requests.size()), send_requests.data(), &flag,
+                        MPI_STATUSES_IGNORE);
+            if (flag != 0) {
+              MPI_Ibarrier(context.comm, &barrier_request);
+              ticket.punch();
+              barrier_entered = true;
+            }
+          }
+        }
+      }
+
       // === reduce ===
       // --- blocking reduce ---
       /// Performs a reduction operation over all processes.
@@ -3915,6 +5191,47 @@ namespace mpl {
       }
 
       // --- non-blocking reduce ---
+    protected:
+      // non-blocking reduction with a function object that has state, the task holds the
+      // function object's slot in the pool of reduction operations until the reduction has
+      // completed
+      template<typename T, typename F>
+      class ireduction_task final : public progress_task {
+        detail::reduction_op<T, F> op_;
+        MPI_Request req_;
+
+      public:
+        ireduction_task(detail::reduction_op<T, F> &&op, MPI_Request req)
+            : op_{std::move(op)}, req_{req} {
+        }
+
+        bool progress() override {
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          complete(s);
+          return true;
+        }
+      };
+
+      template<typename T, typename F>
+      static MPI_Request ireduction_mpi_request(detail::reduction_op<T, F> &&op,
+                                                MPI_Request req) {
+        if constexpr (detail::reduction_op<T, F>::is_stateful)
+          return get_progress_engine().start(
+              std::make_unique<ireduction_task<T, F>>(std::move(op), req));
+        else
+          return req;
+      }
+
+      template<typename T, typename F>
+      static irequest ireduction_request(detail::reduction_op<T, F> &&op, MPI_Request req) {
+        return base_irequest{ireduction_mpi_request(std::move(op), req)};
+      }
+
+    public:
       /// Performs a reduction operation over all processes in a non-blocking manner.
       /// \tparam F type representing the reduction operation, reduction operation is performed
       /// on data of type \c T
@@ -3931,10 +5248,11 @@ namespace mpl {
       template<typename T, typename F>
       irequest ireduce(F f, int root_rank, const T &send_data, T &recv_data) const {
         check_root(root_rank);
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Ireduce(&send_data, &recv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                    detail::get_op<T, F>(f).mpi_op, root_rank, comm_, &req);
-        return base_irequest{req};
+                    op.mpi_op, root_rank, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       /// Performs a reduction operation over all processes in a non-blocking manner.
@@ -3956,10 +5274,11 @@ namespace mpl {
       irequest ireduce(F f, int root_rank, const T *send_data, T *recv_data,
                        const contiguous_layout<T> &l) const {
         check_root(root_rank);
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Ireduce(send_data, recv_data, l.size(), detail::datatype_traits<T>::get_datatype(),
-                    detail::get_op<T, F>(f).mpi_op, root_rank, comm_, &req);
-        return base_irequest{req};
+                    op.mpi_op, root_rank, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       // === all-reduce ===
@@ -4001,6 +5320,18 @@ namespace mpl {
                       detail::get_op<T, F>(f).mpi_op, comm_);
       }
 
+      /// Performs all reduction operations of a batch over all processes and broadcasts the
+      /// results by a single collective communication operation.
+      /// \param batch reduction operations to perform, the results are assigned to the
+      /// receive objects that have been specified when adding the reduction operations to
+      /// the batch
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      /// \see allreduce_batch
+      void allreduce(allreduce_batch &batch) const {
+        batch.allreduce(comm_);
+      }
+
       // --- non-blocking all-reduce ---
       /// Performs a reduction operation over all processes and broadcasts the result in a
       /// non-blocking manner.
@@ -4017,10 +5348,11 @@ namespace mpl {
       /// overload) by all processes in the communicator.
       template<typename T, typename F>
       irequest iallreduce(F f, const T &send_data, T &recv_data) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Iallreduce(&send_data, &recv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                       detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                       op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       /// Performs a reduction operation over all processes and broadcasts the result in a
@@ -4040,11 +5372,85 @@ namespace mpl {
       template<typename T, typename F>
       irequest iallreduce(F f, const T *send_data, T *recv_data,
                           const contiguous_layout<T> &l) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Iallreduce(send_data, recv_data, l.size(),
                        detail::datatype_traits<T>::get_datatype(),
-                       detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                       op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
+      }
+
+      /// Performs all reduction operations of a batch over all processes and broadcasts the
+      /// results by a single collective communication operation in a non-blocking manner.
+      /// \param batch reduction operations to perform, the results are assigned to the
+      /// receive objects that have been specified when adding the reduction operations to
+      /// the batch when the operation has completed
+      /// \return request representing the ongoing reduction operation
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      /// \see allreduce_batch
+      irequest iallreduce(allreduce_batch &batch) const {
+        return base_irequest{get_progress_engine().start(
+            std::make_unique<allreduce_batch::iallreduce_task>(batch, comm_))};
+      }
+
+      // --- persistent all-reduce ---
+      /// Creates a persistent request for performing a reduction operation over all processes
+      /// and broadcasting the result.
+      /// \tparam F type representing the reduction operation, reduction operation is performed
+      /// on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input data for the reduction operation
+      /// \param recv_data will hold the result of the reduction operation
+      /// \return persistent request, the reduction is carried out each time the request is
+      /// started
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.  The request must be started by all
+      /// processes in the same order as other collective operations.  The reduction is always
+      /// emulated by a non-blocking reduction, which is started each time the request is
+      /// started.
+      template<typename T, typename F>
+      prequest allreduce_init(F f, const T &send_data, T &recv_data) const {
+        const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+        return emulated_prequest([f, send_data = &send_data, recv_data = &recv_data, datatype,
+                                  comm = comm_]() {
+          auto op{detail::get_op<T, F>(f)};
+          MPI_Request req;
+          MPI_Iallreduce(send_data, recv_data, 1, datatype, op.mpi_op, comm, &req);
+          return ireduction_mpi_request(std::move(op), req);
+        });
+      }
+
+      /// Creates a persistent request for performing a reduction operation over all processes
+      /// and broadcasting the result.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation
+      /// is performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input data for the reduction operation
+      /// \param recv_data will hold the results of the reduction operation
+      /// \param l memory layouts of the data to send and to receive
+      /// \return persistent request, the reduction is carried out each time the request is
+      /// started
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.  The request must be started by all
+      /// processes in the same order as other collective operations.
+      template<typename T, typename F>
+      prequest allreduce_init(F f, const T *send_data, T *recv_data,
+                              const contiguous_layout<T> &l) const {
+        const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+        const int count{static_cast<int>(l.size())};
+        return emulated_prequest([f, send_data, recv_data, count, datatype, comm = comm_]() {
+          auto op{detail::get_op<T, F>(f)};
+          MPI_Request req;
+          MPI_Iallreduce(send_data, recv_data, count, datatype, op.mpi_op, comm, &req);
+          return ireduction_mpi_request(std::move(op), req);
+        });
       }
 
       // === reduce-scatter-block ===
@@ -4107,11 +5513,12 @@ namespace mpl {
       /// overload) by all processes in the communicator.
       template<typename T, typename F>
       irequest ireduce_scatter_block(F f, const T *send_data, T &recv_data) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Ireduce_scatter_block(send_data, &recv_data, 1,
                                   detail::datatype_traits<T>::get_datatype(),
-                                  detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                                  op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       /// Performs a reduction operation over all processes and scatters the result in a
@@ -4133,11 +5540,12 @@ namespace mpl {
       template<typename T, typename F>
       irequest ireduce_scatter_block(F f, const T *send_data, T *recv_data,
                                      const contiguous_layout<T> &recvcount) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Ireduce_scatter_block(send_data, recv_data, recvcount.size(),
                                   detail::datatype_traits<T>::get_datatype(),
-                                  detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                                  op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       // === reduce-scatter ===
@@ -4184,11 +5592,12 @@ namespace mpl {
       template<typename T, typename F>
       irequest ireduce_scatter(F f, const T *send_data, T *recv_data,
                                contiguous_layouts<T> &recvcounts) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Ireduce_scatter(send_data, recv_data, recvcounts.sizes(),
                             detail::datatype_traits<T>::get_datatype(),
-                            detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                            op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       // === scan ===
@@ -4244,10 +5653,11 @@ namespace mpl {
       /// overload) by all processes in the communicator.
       template<typename T, typename F>
       irequest iscan(F f, const T &send_data, T &recv_data) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Iscan(&send_data, &recv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                  detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                  op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       /// Performs a partial reduction operation (scan) over all processes in a
@@ -4267,10 +5677,11 @@ namespace mpl {
       template<typename T, typename F>
       irequest iscan(F f, const T *send_data, T *recv_data,
                      const contiguous_layout<T> &l) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Iscan(send_data, recv_data, l.size(), detail::datatype_traits<T>::get_datatype(),
-                  detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                  op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       // === exscan ===
@@ -4326,10 +5737,11 @@ namespace mpl {
       /// overload) by all processes in the communicator.
       template<typename T, typename F>
       irequest iexscan(F f, const T &send_data, T &recv_data) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Iexscan(&send_data, &recv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                    detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                    op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
 
       /// Performs a partial reduction operation (exclusive scan) over all processes in a
@@ -4349,10 +5761,11 @@ namespace mpl {
       template<typename T, typename F>
       irequest iexscan(F f, const T *send_data, T *recv_data,
                        const contiguous_layout<T> &l) const {
+        auto op{detail::get_op<T, F>(f)};
         MPI_Request req;
         MPI_Iexscan(send_data, recv_data, l.size(), detail::datatype_traits<T>::get_datatype(),
-                    detail::get_op<T, F>(f).mpi_op, comm_, &req);
-        return base_irequest{req};
+                    op.mpi_op, comm_, &req);
+        return ireduction_request(std::move(op), req);
       }
     };
   }  // namespace impl
@@ -4578,6 +5991,167 @@ namespace mpl {
       return static_cast<equality_type>(result);
     }
 
+    // === gather ===
+    using base::gatherv;
+    using base::igatherv;
+
+    // --- gather of containers ---
+    /// Gather containers of varying size from all processes at a single root process.  The
+    /// numbers of elements are exchanged internally.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator type
+    /// \param root_rank rank of the receiving process
+    /// \param send_data data to send
+    /// \param recv_data will hold the gathered data on the root process, the i-th block
+    /// holds the data of the i-th process, is not accessed on non-root processes
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.
+    template<typename T, typename A>
+    void gatherv(int root_rank, const std::vector<T, A> &send_data,
+                 csr_vector<T> &recv_data) const {
+      check_root(root_rank);
+      check_container_size(send_data);
+      const bool is_root{rank() == root_rank};
+      const int count{static_cast<int>(send_data.size())};
+      std::vector<int> counts(is_root ? size() : 0);
+      MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, root_rank, comm_);
+      std::vector<int> displs;
+      if (is_root) {
+        recv_data.assign_counts(counts.data(), size());
+        displs = csr_displacements(recv_data);
+      }
+      MPI_Gatherv(send_data.data(), count, detail::datatype_traits<T>::get_datatype(),
+                  is_root ? recv_data.values().data() : nullptr, counts.data(), displs.data(),
+                  detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+    }
+
+    /// Gather containers of varying size from all processes at a single root process in a
+    /// non-blocking manner.  The numbers of elements are exchanged internally.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator type
+    /// \param root_rank rank of the receiving process
+    /// \param send_data data to send
+    /// \param recv_data will hold the gathered data on the root process, the i-th block
+    /// holds the data of the i-th process, is not accessed on non-root processes
+    /// \return request representing the ongoing message transfer
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.
+    template<typename T, typename A>
+    irequest igatherv(int root_rank, const std::vector<T, A> &send_data,
+                      csr_vector<T> &recv_data) const {
+      check_root(root_rank);
+      check_container_size(send_data);
+      return impl::base_irequest{impl::get_progress_engine().start(
+          std::make_unique<igatherv_container_task<T>>(
+              send_data.data(), static_cast<int>(send_data.size()),
+              rank() == root_rank ? &recv_data : nullptr, root_rank, size(), comm_,
+              collective_ticket{get_shared_collective_context()}))};
+    }
+
+    // --- gather of serialized objects ---
+    /// Gather objects of varying serialized size from all processes at a single root
+    /// process.  The objects are serialized into a byte buffer, the sizes of the serialized
+    /// data are exchanged internally.
+    /// \tparam T type of the data to send, must be serializable as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the receiving process
+    /// \param send_data data to send
+    /// \param recv_data will hold the gathered data on the root process, the i-th element
+    /// holds the data of the i-th process, is not accessed on non-root processes
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    /// \see \c serialization
+    template<typename T, typename A>
+    void gatherv(int root_rank, const T &send_data, std::vector<T, A> &recv_data) const {
+      static_assert(detail::is_serializable_v<T>, "type is not serializable");
+      check_root(root_rank);
+      const bool is_root{rank() == root_rank};
+      detail::pooled_buffer send_buffer;
+      output_archive ar(send_buffer.get());
+      ar << send_data;
+#if defined MPL_DEBUG
+      if (ar.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        throw invalid_count();
+#endif
+      const int count{static_cast<int>(ar.size())};
+      std::vector<int> counts(is_root ? size() : 0);
+      MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, root_rank, comm_);
+      std::vector<int> displs(counts.size());
+      detail::pooled_buffer recv_buffer;
+      if (is_root) {
+        std::size_t total{0};
+        for (std::size_t i{0}; i < counts.size(); ++i) {
+          displs[i] = static_cast<int>(total);
+          total += counts[i];
+        }
+#if defined MPL_DEBUG
+        if (total > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+          throw invalid_count();
+#endif
+        recv_buffer.get().resize(total);
+      }
+      MPI_Gatherv(ar.data(), count, MPI_BYTE, recv_buffer.get().data(), counts.data(),
+                  displs.data(), MPI_BYTE, root_rank, comm_);
+      if (is_root) {
+        recv_data.resize(counts.size());
+        for (std::size_t i{0}; i < counts.size(); ++i) {
+          input_archive in(recv_buffer.get().data() + displs[i], counts[i]);
+          in >> recv_data[i];
+        }
+      }
+    }
+
+    // === all-gather ===
+    using base::allgatherv;
+    using base::iallgatherv;
+
+    // --- all-gather of containers ---
+    /// Gather containers of varying size from all processes and distribute the result to
+    /// all processes.  The numbers of elements are exchanged internally.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator type
+    /// \param send_data data to send
+    /// \param recv_data will hold the gathered data, the i-th block holds the data of the
+    /// i-th process
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.
+    template<typename T, typename A>
+    void allgatherv(const std::vector<T, A> &send_data, csr_vector<T> &recv_data) const {
+      check_container_size(send_data);
+      const int count{static_cast<int>(send_data.size())};
+      std::vector<int> counts(size());
+      MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, comm_);
+      recv_data.assign_counts(counts.data(), size());
+      const auto displs{csr_displacements(recv_data)};
+      MPI_Allgatherv(send_data.data(), count, detail::datatype_traits<T>::get_datatype(),
+                     recv_data.values().data(), counts.data(), displs.data(),
+                     detail::datatype_traits<T>::get_datatype(), comm_);
+    }
+
+    /// Gather containers of varying size from all processes and distribute the result to
+    /// all processes in a non-blocking manner.  The numbers of elements are exchanged
+    /// internally.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator type
+    /// \param send_data data to send
+    /// \param recv_data will hold the gathered data, the i-th block holds the data of the
+    /// i-th process
+    /// \return request representing the ongoing message transfer
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.
+    template<typename T, typename A>
+    irequest iallgatherv(const std::vector<T, A> &send_data, csr_vector<T> &recv_data) const {
+      check_container_size(send_data);
+      return impl::base_irequest{impl::get_progress_engine().start(
+          std::make_unique<igatherv_container_task<T>>(
+              send_data.data(), static_cast<int>(send_data.size()), &recv_data, std::nullopt,
+              size(), comm_, collective_ticket{get_shared_collective_context()}))};
+    }
+
     // === all-to-all ===
     // === each rank sends a single value to each rank
     using base::alltoall;
@@ -4703,9 +6277,9 @@ namespace mpl {
       check_size(sendrecvls);
       const std::vector<int> counts(sendrecvls.size(), 1);
       const std::vector<int> sendrecvdispls_int(sendrecvdispls.begin(), sendrecvdispls.end());
+      const auto sendrecvtypes{sendrecvls.datatypes()};
       MPI_Alltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, sendrecv_data, counts.data(),
-                    sendrecvdispls_int.data(),
-                    reinterpret_cast<const MPI_Datatype *>(sendrecvls()), comm_);
+                    sendrecvdispls_int.data(), sendrecvtypes.data(), comm_);
     }
 
     /// Sends messages with a variable amount of data to all processes and receives
@@ -4755,20 +6329,10 @@ namespace mpl {
                         const displacements &sendrecvdispls) const {
       check_size(sendrecvdispls);
       check_size(sendrecvls);
-      auto *request_state{new ialltoallv_request_state()};
-      MPI_Request req;
-      MPI_Grequest_start(ialltoallv_query, ialltoallv_free, ialltoallv_cancel, request_state,
-                         &req);
-      auto *alltoall_state{new ialltoallv_state<T>(
-          sendrecvls, std::vector<int>(sendrecvls.size(), 1),
-          std::vector<int>(sendrecvdispls.begin(), sendrecvdispls.end()))};
-      alltoall_state->req = req;
-      alltoall_state->request_state = request_state;
-      std::thread thread([this, sendrecv_data, alltoall_state]() {
-        ialltoallv_task(static_cast<T *>(nullptr), sendrecv_data, alltoall_state);
-      });
-      thread.detach();
-      return impl::base_irequest{req};
+      return impl::base_irequest{
+          impl::get_progress_engine().start(std::make_unique<ialltoallw_task>(
+              sendrecv_data, sendrecvls, byte_displacements_as_vector_of_ints(sendrecvdispls),
+              comm_))};
     }
 
     /// Sends messages with a variable amount of data to all processes and receives
@@ -4902,14 +6466,15 @@ namespace mpl {
     template<typename T, typename F>
     irequest ireduce(F f, int root_rank, T &sendrecv_data) const {
       check_root(root_rank);
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       if (rank() == root_rank)
         MPI_Ireduce(MPI_IN_PLACE, &sendrecv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                    detail::get_op<T, F>(f).mpi_op, root_rank, comm_, &req);
+                    op.mpi_op, root_rank, comm_, &req);
       else
         MPI_Ireduce(&sendrecv_data, nullptr, 1, detail::datatype_traits<T>::get_datatype(),
-                    detail::get_op<T, F>(f).mpi_op, root_rank, comm_, &req);
-      return impl::base_irequest{req};
+                    op.mpi_op, root_rank, comm_, &req);
+      return ireduction_request(std::move(op), req);
     }
 
     /// Performs a reduction operation over all processes in a non-blocking manner,
@@ -4928,10 +6493,11 @@ namespace mpl {
     template<typename T, typename F>
     irequest ireduce(F f, int root_rank, const T &send_data) const {
       check_nonroot(root_rank);
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Ireduce(&send_data, nullptr, 1, detail::datatype_traits<T>::get_datatype(),
-                  detail::get_op<T, F>(f).mpi_op, root_rank, comm_, &req);
-      return impl::base_irequest{req};
+                  op.mpi_op, root_rank, comm_, &req);
+      return ireduction_request(std::move(op), req);
     }
 
     /// Performs a reduction operation over all processes in non-blocking manner,
@@ -4953,16 +6519,17 @@ namespace mpl {
     irequest ireduce(F f, int root_rank, T *sendrecv_data,
                      const contiguous_layout<T> &l) const {
       check_root(root_rank);
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       if (rank() == root_rank)
         MPI_Ireduce(MPI_IN_PLACE, sendrecv_data, l.size(),
-                    detail::datatype_traits<T>::get_datatype(), detail::get_op<T, F>(f).mpi_op,
+                    detail::datatype_traits<T>::get_datatype(), op.mpi_op,
                     root_rank, comm_, &req);
       else
         MPI_Ireduce(sendrecv_data, nullptr, l.size(),
-                    detail::datatype_traits<T>::get_datatype(), detail::get_op<T, F>(f).mpi_op,
+                    detail::datatype_traits<T>::get_datatype(), op.mpi_op,
                     root_rank, comm_, &req);
-      return impl::base_irequest{req};
+      return ireduction_request(std::move(op), req);
     }
 
     /// Performs a reduction operation over all processes in a non-blocking manner,
@@ -4984,10 +6551,11 @@ namespace mpl {
     irequest ireduce(F f, int root_rank, const T *send_data,
                      const contiguous_layout<T> &l) const {
       check_nonroot(root_rank);
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Ireduce(send_data, nullptr, l.size(), detail::datatype_traits<T>::get_datatype(),
-                  detail::get_op<T, F>(f).mpi_op, root_rank, comm_, &req);
-      return impl::base_irequest{req};
+                  op.mpi_op, root_rank, comm_, &req);
+      return ireduction_request(std::move(op), req);
     }
 
     // === all-reduce ===
@@ -5031,6 +6599,63 @@ namespace mpl {
                     comm_);
     }
 
+    /// Performs a reduction operation over all processes and broadcasts the result by a
+    /// pipelined ring algorithm.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation is
+    /// performed on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param policy selects the ring algorithm and its chunk size
+    /// \param f reduction operation
+    /// \param send_data input buffer for the reduction operation
+    /// \param recv_data will hold the results of the reduction operation
+    /// \param l memory layouts of the data to send and to receive
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator with the same policy.
+    /// \see ring_allreduce
+    template<typename T, typename F>
+    void allreduce(const ring_allreduce &policy, F f, const T *send_data, T *recv_data,
+                   const contiguous_layout<T> &l) const {
+      const int n{static_cast<int>(l.size())};
+      if constexpr (op_traits<F>::is_commutative) {
+        if (size() > 1 and n >= size()) {
+          detail::allreduce_ring(f, send_data, recv_data, n, get_collective_context().comm,
+                                 policy.chunk_size());
+          return;
+        }
+      }
+      allreduce(f, send_data, recv_data, l);
+    }
+
+    /// Performs a reduction operation over all processes and broadcasts the result by a
+    /// pipelined ring algorithm, in-place variant.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation is
+    /// performed on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param policy selects the ring algorithm and its chunk size
+    /// \param f reduction operation
+    /// \param sendrecv_data input buffer for the reduction operation
+    /// \param l memory layouts of the data to send and to receive
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator with the same policy.
+    /// \see ring_allreduce
+    template<typename T, typename F>
+    void allreduce(const ring_allreduce &policy, F f, T *sendrecv_data,
+                   const contiguous_layout<T> &l) const {
+      const int n{static_cast<int>(l.size())};
+      if constexpr (op_traits<F>::is_commutative) {
+        if (size() > 1 and n >= size()) {
+          detail::allreduce_ring(f, sendrecv_data, sendrecv_data, n,
+                                 get_collective_context().comm, policy.chunk_size());
+          return;
+        }
+      }
+      allreduce(f, sendrecv_data, l);
+    }
+
     // --- non-blocking all-reduce, in place ---
     /// Performs a reduction operation over all processes and broadcasts the result in a
     /// non-blocking manner, in-place variant.
@@ -5046,11 +6671,12 @@ namespace mpl {
     /// overload) by all processes in the communicator.
     template<typename T, typename F>
     irequest iallreduce(F f, T &sendrecv_data) const {
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Iallreduce(MPI_IN_PLACE, &sendrecv_data, 1,
-                     detail::datatype_traits<T>::get_datatype(), detail::get_op<T, F>(f).mpi_op,
+                     detail::datatype_traits<T>::get_datatype(), op.mpi_op,
                      comm_, &req);
-      return impl::base_irequest{req};
+      return ireduction_request(std::move(op), req);
     }
 
     /// Performs a reduction operation over all processes and broadcasts the result in
@@ -5068,11 +6694,84 @@ namespace mpl {
     /// overload) by all processes in the communicator.
     template<typename T, typename F>
     irequest iallreduce(F f, T *sendrecv_data, const contiguous_layout<T> &l) const {
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Iallreduce(MPI_IN_PLACE, sendrecv_data, l.size(),
-                     detail::datatype_traits<T>::get_datatype(), detail::get_op<T, F>(f).mpi_op,
+                     detail::datatype_traits<T>::get_datatype(), op.mpi_op,
                      comm_, &req);
-      return impl::base_irequest{req};
+      return ireduction_request(std::move(op), req);
+    }
+
+    // --- sparse all-reduce ---
+    /// Performs an element-wise reduction operation on sparse vectors over all processes and
+    /// broadcasts the result.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation is
+    /// performed on data of type \c T
+    /// \tparam T type of the vector elements, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param f reduction operation
+    /// \param n length of the vectors
+    /// \param send_data non-zero elements of the vector of this process given as value-index
+    /// pairs, indices must be within the range from 0 to n - 1, elements with equal indices
+    /// are combined by the reduction operation in the order of their occurrence
+    /// \param recv_data will hold all elements that are present in the vector of at least
+    /// one process as value-index pairs sorted by index, previous content is discarded
+    /// \param fill_ratio partial results are switched from a sparse representation as
+    /// value-index pairs to a dense representation as soon as the ratio of present elements
+    /// to the vector length exceeds this threshold
+    /// \details Partial results are merged by a recursive-doubling algorithm, elements that
+    /// are absent in all vectors are never sent.  The result of an element is the reduction
+    /// of the values of all processes that hold this element in the order of their ranks.
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator with equal values of n and fill_ratio.
+    template<typename T, typename F>
+    void sparse_allreduce(F f, int n, const std::vector<value_index<T>> &send_data,
+                          std::vector<value_index<T>> &recv_data, double fill_ratio) const {
+#if defined MPL_DEBUG
+      if (n < 0)
+        throw invalid_size();
+      for (const auto &entry : send_data)
+        if (entry.index < 0 or entry.index >= n)
+          throw invalid_argument();
+#endif
+      std::vector<value_index<T>> sorted(send_data);
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [](const auto &a, const auto &b) { return a.index < b.index; });
+      std::vector<value_index<T>> entries;
+      entries.reserve(sorted.size());
+      for (const auto &entry : sorted)
+        if (not entries.empty() and entries.back().index == entry.index)
+          entries.back().value = f(entries.back().value, entry.value);
+        else
+          entries.push_back(entry);
+      const auto max_entries{static_cast<std::size_t>(std::max(fill_ratio, 0.0) * n)};
+      recv_data = detail::sparse_allreduce_recursive_doubling(
+          f, n, std::move(entries), max_entries, get_collective_context().comm);
+    }
+
+    /// Performs an element-wise reduction operation on sparse vectors over all processes and
+    /// broadcasts the result, partial results are switched to a dense representation when
+    /// the dense representation becomes more compact than the sparse one.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation is
+    /// performed on data of type \c T
+    /// \tparam T type of the vector elements, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param f reduction operation
+    /// \param n length of the vectors
+    /// \param send_data non-zero elements of the vector of this process given as value-index
+    /// pairs, indices must be within the range from 0 to n - 1, elements with equal indices
+    /// are combined by the reduction operation in the order of their occurrence
+    /// \param recv_data will hold all elements that are present in the vector of at least
+    /// one process as value-index pairs sorted by index, previous content is discarded
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator with equal values of n.
+    template<typename T, typename F>
+    void sparse_allreduce(F f, int n, const std::vector<value_index<T>> &send_data,
+                          std::vector<value_index<T>> &recv_data) const {
+      // a dense vector requires one value and one bit per element
+      const double fill_ratio{(static_cast<double>(sizeof(T)) + 0.125) /
+                              static_cast<double>(sizeof(value_index<T>))};
+      sparse_allreduce(f, n, send_data, recv_data, fill_ratio);
     }
 
     // === scan ===
@@ -5131,10 +6830,11 @@ namespace mpl {
     /// overload) by all processes in the communicator.
     template<typename T, typename F>
     irequest iscan(F f, T &sendrecv_data) const {
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Iscan(MPI_IN_PLACE, &sendrecv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                detail::get_op<T, F>(f).mpi_op, comm_, &req);
-      return impl::base_irequest{req};
+                op.mpi_op, comm_, &req);
+      return ireduction_request(std::move(op), req);
     }
 
     /// Performs a partial reduction (scan) operation over all processes in a
@@ -5152,11 +6852,12 @@ namespace mpl {
     /// overload) by all processes in the communicator.
     template<typename T, typename F>
     irequest iscan(F f, T *sendrecv_data, const contiguous_layout<T> &l) const {
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Iscan(MPI_IN_PLACE, sendrecv_data, l.size(),
-                detail::datatype_traits<T>::get_datatype(), detail::get_op<T, F>(f).mpi_op,
+                detail::datatype_traits<T>::get_datatype(), op.mpi_op,
                 comm_, &req);
-      return impl::base_irequest{req};
+      return ireduction_request(std::move(op), req);
     }
 
     // === exscan ===
@@ -5215,10 +6916,11 @@ namespace mpl {
     /// overload) by all processes in the communicator.
     template<typename T, typename F>
     irequest iexscan(F f, T &sendrecv_data) const {
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Iexscan(MPI_IN_PLACE, &sendrecv_data, 1, detail::datatype_traits<T>::get_datatype(),
-                  detail::get_op<T, F>(f).mpi_op, comm_, &req);
-      return impl::base_irequest{req};
+                  op.mpi_op, comm_, &req);
+      return ireduction_request(std::move(op), req);
     }
 
     /// Performs a partial reduction operation (exclusive scan) over all processes in a
@@ -5236,11 +6938,12 @@ namespace mpl {
     /// overload) by all processes in the communicator.
     template<typename T, typename F>
     irequest iexscan(F f, T *sendrecv_data, const contiguous_layout<T> &l) const {
+      auto op{detail::get_op<T, F>(f)};
       MPI_Request req;
       MPI_Iexscan(MPI_IN_PLACE, sendrecv_data, l.size(),
-                  detail::datatype_traits<T>::get_datatype(), detail::get_op<T, F>(f).mpi_op,
+                  detail::datatype_traits<T>::get_datatype(), op.mpi_op,
                   comm_, &req);
-      return impl::base_irequest{req};
+      return ireduction_request(std::move(op), req);
     }
 
     /// Spawns new processes and establishes communication.
@@ -5682,6 +7385,16 @@ namespace mpl {
 
   //--------------------------------------------------------------------
 
+  inline packed_message::packed_message(const communicator &comm)
+      : comm_{comm.native_handle()} {
+  }
+
+  inline packed_message::packed_message(const inter_communicator &comm)
+      : comm_{comm.native_handle()} {
+  }
+
+  //--------------------------------------------------------------------
+
   inline group::group(const group &other) {
     MPI_Group_excl(other.gr_, 0, nullptr, &gr_);
   }
@@ -0,0 +1,157 @@
+#if !(defined MPL_CSR_VECTOR_HPP)
+
+#define MPL_CSR_VECTOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace mpl {
+
+  class communicator;
+
+  namespace impl {
+    class base_communicator;
+  }
+
+  namespace detail {
+
+    // allocator that default-initializes instead of value-initializes elements, i.e., elements
+    // of trivial types remain uninitialized when a vector is resized
+    template<typename T>
+    class default_init_allocator : public std::allocator<T> {
+    public:
+      template<typename U>
+      struct rebind {
+        using other = default_init_allocator<U>;
+      };
+
+      using std::allocator<T>::allocator;
+
+      template<typename U>
+      void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void *>(p)) U;
+      }
+
+      template<typename U, typename... Args>
+      void construct(U *p, Args &&...args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+      }
+    };
+
+  }  // namespace detail
+
+  /// Sequence of blocks of elements of varying size, which are stored contiguously in a single
+  /// buffer.  The blocks are indexed by an array of offsets as in the compressed sparse row
+  /// (CSR) format, i.e., the i-th block consists of the elements with indices
+  /// <tt>offsets()[i]</tt> to <tt>offsets()[i + 1] - 1</tt> in the array <tt>values()</tt>.
+  /// Used to hold the results of gather operations on containers, where the i-th block
+  /// holds the data of the i-th process.
+  /// \tparam T element type
+  template<typename T>
+  class csr_vector {
+  public:
+    /// element type
+    using value_type = T;
+    /// unsigned integer type for sizes and offsets
+    using size_type = std::size_t;
+    /// container type holding the elements of all blocks, elements of trivial types are not
+    /// initialized when the container is resized
+    using values_type = std::vector<T, detail::default_init_allocator<T>>;
+
+  private:
+    values_type values_;
+    std::vector<size_type> offsets_{0};
+
+    // resizes the storage to hold blocks with the given number of elements each, previous
+    // elements are discarded before resizing such that they are not copied on reallocation
+    void assign_counts(const int *counts, int n) {
+      offsets_.resize(static_cast<size_type>(n) + 1);
+      offsets_[0] = 0;
+      for (int i{0}; i < n; ++i)
+        offsets_[i + 1] = offsets_[i] + static_cast<size_type>(counts[i]);
+      values_.clear();
+      values_.resize(offsets_.back());
+    }
+
+  public:
+    /// Creates an empty sequence of blocks.
+    csr_vector() = default;
+
+    /// \return number of blocks
+    [[nodiscard]] size_type size() const {
+      return offsets_.size() - 1;
+    }
+
+    /// \return true if there are no blocks
+    [[nodiscard]] bool empty() const {
+      return size() == 0;
+    }
+
+    /// \param i block index
+    /// \return number of elements in the i-th block
+    [[nodiscard]] size_type block_size(size_type i) const {
+      return offsets_[i + 1] - offsets_[i];
+    }
+
+    /// \param i block index
+    /// \return pointer to the first element of the i-th block
+    T *begin(size_type i) {
+      return values_.data() + offsets_[i];
+    }
+
+    /// \param i block index
+    /// \return pointer to the first element of the i-th block
+    const T *begin(size_type i) const {
+      return values_.data() + offsets_[i];
+    }
+
+    /// \param i block index
+    /// \return pointer past the last element of the i-th block
+    T *end(size_type i) {
+      return values_.data() + offsets_[i + 1];
+    }
+
+    /// \param i block index
+    /// \return pointer past the last element of the i-th block
+    const T *end(size_type i) const {
+      return values_.data() + offsets_[i + 1];
+    }
+
+    /// \return elements of all blocks
+    [[nodiscard]] const values_type &values() const {
+      return values_;
+    }
+
+    /// \return elements of all blocks
+    values_type &values() {
+      return values_;
+    }
+
+    /// Moves the elements of all blocks out of this object, which is left without any
+    /// blocks.
+    /// \return elements of all blocks
+    [[nodiscard]] values_type release_values() {
+      values_type values{std::move(values_)};
+      values_.clear();
+      offsets_.assign(1, 0);
+      return values;
+    }
+
+    /// \return offsets of the blocks, has one more element than there are blocks
+    [[nodiscard]] const std::vector<size_type> &offsets() const {
+      return offsets_;
+    }
+
+    friend class impl::base_communicator;
+
+    friend class communicator;
+  };
+
+}  // namespace mpl
+
+#endif
@@ -3,6 +3,7 @@
 #define MPL_DATATYPE_HPP
 
 #include <mpi.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -16,6 +17,7 @@
 #include <string>
 #include <valarray>
 #include <complex>
+#include <numeric>
 #include <utility>
 #include <tuple>
 #include <array>
@@ -127,6 +129,28 @@ namespace mpl {
     std::vector<MPI_Aint> displacements_;
     std::vector<MPI_Datatype> data_types_;
 
+    // checks if the registered members cover the memory of a struct of the given size
+    // without any gaps, i.e., the struct has no padding and all members have been registered
+    bool is_contiguous(std::size_t struct_size) const {
+      std::vector<std::size_t> order(displacements_.size());
+      std::iota(order.begin(), order.end(), std::size_t{0});
+      std::sort(order.begin(), order.end(), [this](std::size_t i, std::size_t j) {
+        return displacements_[i] < displacements_[j];
+      });
+      MPI_Aint end{0};
+      for (const auto i : order) {
+        int size;
+        MPI_Aint lower_bound, extent;
+        MPI_Type_size(data_types_[i], &size);
+        MPI_Type_get_extent(data_types_[i], &lower_bound, &extent);
+        // members must be adjacent and must not have any holes themselves
+        if (displacements_[i] != end or lower_bound != 0 or extent != size)
+          return false;
+        end += block_lengths_[i] * extent;
+      }
+      return end == static_cast<MPI_Aint>(struct_size);
+    }
+
   public:
     /// starts to register a struct type
     /// \param x an instance of type \c S (the template parameter of class \c struct_layout)
@@ -157,6 +181,80 @@ namespace mpl {
 
   //--------------------------------------------------------------------
 
+  namespace detail {
+
+    // Creates a data type from the blocks of a struct layout.  The layout is normalized
+    // first, i.e., the blocks are sorted by their displacements and adjacent blocks of the
+    // same type are merged into a single block.  The resulting blocks are described by the
+    // least general MPI type constructor that applies, such that MPI can use simpler code
+    // paths when packing and unpacking data of this type.
+    inline MPI_Datatype create_struct_type(const std::vector<int> &block_lengths,
+                                           const std::vector<MPI_Aint> &displacements,
+                                           const std::vector<MPI_Datatype> &data_types) {
+      std::vector<std::size_t> order(displacements.size());
+      std::iota(order.begin(), order.end(), std::size_t{0});
+      std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+        return displacements[i] < displacements[j];
+      });
+      std::vector<int> lengths;
+      std::vector<MPI_Aint> displs;
+      std::vector<MPI_Datatype> types;
+      for (const auto i : order) {
+        if (block_lengths[i] == 0)
+          continue;
+        if (not types.empty() and types.back() == data_types[i]) {
+          MPI_Aint lower_bound, extent;
+          MPI_Type_get_extent(data_types[i], &lower_bound, &extent);
+          if (displs.back() + lengths.back() * extent == displacements[i]) {
+            lengths.back() += block_lengths[i];
+            continue;
+          }
+        }
+        lengths.push_back(block_lengths[i]);
+        displs.push_back(displacements[i]);
+        types.push_back(data_types[i]);
+      }
+      const auto count{static_cast<int>(types.size())};
+      const bool same_type{
+          count > 0 and std::all_of(types.begin(), types.end(),
+                                    [&](MPI_Datatype type) { return type == types.front(); })};
+      const bool same_length{std::all_of(lengths.begin(), lengths.end(),
+                                         [&](int length) { return length == lengths.front(); })};
+      bool constant_stride{count > 1};
+      for (int i{2}; i < count and constant_stride; ++i)
+        constant_stride = displs[i] - displs[i - 1] == displs[1] - displs[0];
+      MPI_Datatype type;
+      if (same_type and count == 1 and displs.front() == 0)
+        MPI_Type_contiguous(lengths.front(), types.front(), &type);
+      else if (same_type and same_length and constant_stride and displs.front() == 0)
+        MPI_Type_create_hvector(count, lengths.front(), displs[1] - displs[0], types.front(),
+                                &type);
+      else if (same_type and same_length)
+        MPI_Type_create_hindexed_block(count, lengths.front(), displs.data(), types.front(),
+                                       &type);
+      else if (same_type)
+        MPI_Type_create_hindexed(count, lengths.data(), displs.data(), types.front(), &type);
+      else
+        MPI_Type_create_struct(count, lengths.data(), displs.data(), types.data(), &type);
+      return type;
+    }
+
+  }  // namespace detail
+
+  //--------------------------------------------------------------------
+
+  /// Traits class for storing meta information about structures/classes, whose data members
+  /// are exposed to MPL via a \c struct_builder.
+  /// \tparam T the structure or class type
+  template<typename T>
+  struct struct_traits {
+    /// Is true if objects of type \c T are transferred as contiguous blocks of bytes provided
+    /// that \c T is trivially copyable, has no padding bytes and all its data members have
+    /// been exposed to MPL.  Specializations may enable this option only if all processes
+    /// share the same data representation.
+    static constexpr bool is_bytewise_transferable = false;
+  };
+
   /// Base class used to manage information about structures/classes and their public
   /// members.
   /// \tparam T the structure or class type
@@ -168,9 +266,18 @@ namespace mpl {
 
   protected:
     void define_struct(const struct_layout<T> &str) {
-      MPI_Datatype temp_type;
-      MPI_Type_create_struct(str.block_lengths_.size(), str.block_lengths_.data(),
-                             str.displacements_.data(), str.data_types_.data(), &temp_type);
+      // padding-free trivially copyable structs are transferred as contiguous blocks of bytes
+      // on request, which MPI handles without its general data type engine
+      if constexpr (std::is_trivially_copyable_v<T> and
+                    struct_traits<T>::is_bytewise_transferable) {
+        if (str.is_contiguous(sizeof(T))) {
+          MPI_Type_contiguous(static_cast<int>(sizeof(T)), MPI_BYTE, &type_);
+          MPI_Type_commit(&type_);
+          return;
+        }
+      }
+      MPI_Datatype temp_type{
+          detail::create_struct_type(str.block_lengths_, str.displacements_, str.data_types_)};
       MPI_Type_commit(&temp_type);
       MPI_Type_create_resized(temp_type, 0, sizeof(T), &type_);
       MPI_Type_commit(&type_);
@@ -223,6 +223,42 @@ namespace mpl {
       return detail::get_env().buffer_detach();
     }
 
+    /// Enables the process-wide layout cache.  While the cache is enabled, vector, strided
+    /// vector, indexed block and subarray layouts of the same base type and with equal
+    /// parameters share a single underlying MPI data type.  Constructing a layout that equals a
+    /// cached one does not create a new MPI data type.
+    /// \param capacity maximal number of data types held by the cache
+    /// \note The cache is disabled by default.  Least recently used data types are dropped
+    /// from the cache when its capacity is exceeded.  Layouts referring to a dropped data type
+    /// stay valid.  Layouts that are constructed from some other layout are never cached.
+    /// \see \c disable_layout_cache, \c layout_cache_stats
+    inline void enable_layout_cache(std::size_t capacity = 1024) {
+      // the cache must be destructed before the MPI environment is finalized
+      detail::get_env();
+      mpl::detail::get_layout_cache().enable(capacity);
+    }
+
+    /// Disables the process-wide layout cache and releases all cached data types, which are
+    /// not used by any layout anymore.
+    /// \see \c enable_layout_cache
+    inline void disable_layout_cache() {
+      mpl::detail::get_layout_cache().disable();
+    }
+
+    /// Determines if the process-wide layout cache is enabled.
+    /// \return true if the layout cache is enabled
+    /// \see \c enable_layout_cache
+    inline bool layout_cache_enabled() {
+      return mpl::detail::get_layout_cache().is_enabled();
+    }
+
+    /// Get statistics of the process-wide layout cache.
+    /// \return cache hits, cache misses, number of cached data types and evictions
+    /// \see \c enable_layout_cache
+    inline layout_cache_statistics layout_cache_stats() {
+      return mpl::detail::get_layout_cache().statistics();
+    }
+
   }  // namespace environment
 
   //--------------------------------------------------------------------
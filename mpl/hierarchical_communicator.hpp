@@ -0,0 +1,345 @@
+#if !(defined MPL_HIERARCHICAL_COMMUNICATOR_HPP)
+
+#define MPL_HIERARCHICAL_COMMUNICATOR_HPP
+
+#include <mpi.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <mpl/comm_group.hpp>
+#include <mpl/displacements.hpp>
+#include <mpl/error.hpp>
+#include <mpl/layout.hpp>
+
+
+namespace mpl {
+
+  /// Two-level view of a communicator for node-aware collective operations.  The processes of
+  /// the communicator are grouped into nodes, by default into sets of processes that can
+  /// create a shared memory region.  The lowest ranking process of each node acts as the
+  /// node's leader.  Collective operations first combine the data within each node, then
+  /// perform the inter-node part among the node leaders only, and finally distribute the
+  /// result within each node.  Thus, the number of inter-node messages does not depend on the
+  /// number of processes per node.
+  /// \note The intra-node steps are carried out by collective operations on a communicator
+  /// spanning a single node, which MPI implementations realize via shared memory.
+  class hierarchical_communicator {
+    int size_{0};
+    int rank_{0};
+    communicator node_comm_;
+    communicator leader_comm_;
+    // node index and rank within the node of each process
+    std::vector<std::array<int, 2>> locations_;
+    // position of the first process of each node in node-major order, the last element
+    // equals the number of processes
+    std::vector<int> node_offsets_;
+    // ranks of all processes in node-major order
+    std::vector<int> node_major_ranks_;
+    bool is_node_major_{true};
+
+    hierarchical_communicator(const communicator &comm, communicator &&node_comm)
+        : size_{comm.size()},
+          rank_{comm.rank()},
+          node_comm_{std::move(node_comm)},
+          leader_comm_{communicator::split, comm, node_comm_.rank() == 0 ? 0 : undefined} {
+      int node{leader_comm_.is_valid() ? leader_comm_.rank() : 0};
+      node_comm_.bcast(0, node);
+      locations_.resize(size_);
+      comm.allgather(std::array<int, 2>{node, node_comm_.rank()}, locations_.data());
+      int num_nodes{0};
+      for (const auto &l : locations_)
+        num_nodes = std::max(num_nodes, l[0] + 1);
+      node_offsets_.assign(num_nodes + 1, 0);
+      for (const auto &l : locations_)
+        ++node_offsets_[l[0] + 1];
+      for (int i{0}; i < num_nodes; ++i)
+        node_offsets_[i + 1] += node_offsets_[i];
+      node_major_ranks_.resize(size_);
+      for (int r{0}; r < size_; ++r) {
+        const auto [l_node, l_node_rank]{locations_[r]};
+        node_major_ranks_[node_offsets_[l_node] + l_node_rank] = r;
+        is_node_major_ = is_node_major_ and node_offsets_[l_node] + l_node_rank == r;
+      }
+    }
+
+    void check_root([[maybe_unused]] int root_rank) const {
+#if defined MPL_DEBUG
+      if (root_rank < 0 or root_rank >= size())
+        throw invalid_rank();
+#endif
+    }
+
+    [[nodiscard]] int node() const {
+      return locations_[rank_][0];
+    }
+
+    [[nodiscard]] bool has_remote_nodes() const {
+      return is_leader() and num_nodes() > 1;
+    }
+
+    template<typename T>
+    static T *displaced(T *data, std::ptrdiff_t displacement) {
+      return reinterpret_cast<T *>(reinterpret_cast<char *>(data) + displacement);
+    }
+
+  public:
+    /// Creates a two-level view of a communicator, processes that can create a shared memory
+    /// region form a node.
+    /// \param comm the communicator
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    explicit hierarchical_communicator(const communicator &comm)
+        : hierarchical_communicator{comm,
+                                    communicator{communicator::split_shared_memory, comm}} {
+    }
+
+    /// Creates a two-level view of a communicator with a user-defined grouping of processes
+    /// into nodes.
+    /// \tparam color_type color type, must be integral type
+    /// \param comm the communicator
+    /// \param color processes with the same color form a node
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    template<typename color_type>
+    hierarchical_communicator(const communicator &comm, color_type color)
+        : hierarchical_communicator{comm, communicator{communicator::split, comm, color}} {
+    }
+
+    hierarchical_communicator(const hierarchical_communicator &) = delete;
+
+    /// Move-constructs a hierarchical communicator.
+    hierarchical_communicator(hierarchical_communicator &&) noexcept = default;
+
+    void operator=(const hierarchical_communicator &) = delete;
+
+    /// Move-assigns a hierarchical communicator.
+    /// \return this hierarchical communicator
+    hierarchical_communicator &operator=(hierarchical_communicator &&) noexcept = default;
+
+    /// Determines the total number of processes.
+    /// \return number of processes
+    [[nodiscard]] int size() const {
+      return size_;
+    }
+
+    /// Determines the rank within the underlying communicator.
+    /// \return the rank of the calling process
+    [[nodiscard]] int rank() const {
+      return rank_;
+    }
+
+    /// Determines the number of nodes.
+    /// \return number of nodes
+    [[nodiscard]] int num_nodes() const {
+      return static_cast<int>(node_offsets_.size()) - 1;
+    }
+
+    /// Checks if the calling process is the leader of its node.
+    /// \return true if the calling process is the leader of its node
+    [[nodiscard]] bool is_leader() const {
+      return node_comm_.rank() == 0;
+    }
+
+    /// Provides access to the communicator that spans all processes of the calling process'
+    /// node.
+    /// \return communicator of the calling process' node
+    [[nodiscard]] const communicator &node_communicator() const {
+      return node_comm_;
+    }
+
+    /// Provides access to the communicator that spans all node leaders.
+    /// \return communicator of all node leaders, is not valid if the calling process is not a
+    /// node leader
+    [[nodiscard]] const communicator &leader_communicator() const {
+      return leader_comm_;
+    }
+
+    // === barrier ===
+    /// Blocks until all processes have reached this method.
+    /// \note This is a collective operation and must be called by all processes.
+    void barrier() const {
+      node_comm_.barrier();
+      if (has_remote_nodes())
+        leader_comm_.barrier();
+      node_comm_.barrier();
+    }
+
+    // === broadcast ===
+    /// Broadcasts a message from a process to all other processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section or an STL container
+    /// that holds elements that comply with the mentioned requirements
+    /// \param root_rank rank of the sending process
+    /// \param data buffer for sending/receiving data
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void bcast(int root_rank, T &data) const {
+      check_root(root_rank);
+      const auto [root_node, root_node_rank]{locations_[root_rank]};
+      if (node() == root_node)
+        node_comm_.bcast(root_node_rank, data);
+      if (has_remote_nodes())
+        leader_comm_.bcast(root_node, data);
+      if (node() != root_node)
+        node_comm_.bcast(0, data);
+    }
+
+    /// Broadcasts a message from a process to all other processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the sending process
+    /// \param data buffer for sending/receiving data
+    /// \param l memory layout of the data to send/receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void bcast(int root_rank, T *data, const layout<T> &l) const {
+      check_root(root_rank);
+      const auto [root_node, root_node_rank]{locations_[root_rank]};
+      if (node() == root_node)
+        node_comm_.bcast(root_node_rank, data, l);
+      if (has_remote_nodes())
+        leader_comm_.bcast(root_node, data, l);
+      if (node() != root_node)
+        node_comm_.bcast(0, data, l);
+    }
+
+    // === allgather ===
+    /// Gathers messages of the same size from all processes and distributes the result to
+    /// all processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param send_data data to send
+    /// \param recv_data pointer to continuous storage for incoming messages, will hold the
+    /// data of all processes ordered by rank
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void allgather(const T &send_data, T *recv_data) const {
+      const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+      if (is_leader()) {
+        // if processes are in node-major order, data is gathered at its final position
+        std::vector<T> node_major_data(is_node_major_ ? 0 : size_);
+        T *gathered{is_node_major_ ? recv_data : node_major_data.data()};
+        MPI_Gather(&send_data, 1, datatype, gathered + node_offsets_[node()], 1, datatype, 0,
+                   node_comm_.native_handle());
+        if (has_remote_nodes()) {
+          std::vector<int> counts(num_nodes());
+          for (int i{0}; i < num_nodes(); ++i)
+            counts[i] = node_offsets_[i + 1] - node_offsets_[i];
+          MPI_Allgatherv(MPI_IN_PLACE, 0, datatype, gathered, counts.data(),
+                         node_offsets_.data(), datatype, leader_comm_.native_handle());
+        }
+        if (not is_node_major_)
+          for (int i{0}; i < size_; ++i)
+            recv_data[node_major_ranks_[i]] = node_major_data[i];
+      } else
+        MPI_Gather(&send_data, 1, datatype, nullptr, 0, datatype, 0,
+                   node_comm_.native_handle());
+      MPI_Bcast(recv_data, size_, datatype, 0, node_comm_.native_handle());
+    }
+
+    /// Gathers messages with a variable amount of data from all processes and distributes
+    /// the result to all processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param send_data data to send
+    /// \param sendl memory layout of the data to send
+    /// \param recv_data pointer to continuous storage for incoming messages
+    /// \param recvls memory layouts of the data to receive, the i-th layout describes the
+    /// data that is sent by the process with rank i
+    /// \param recvdispls displacements of the data to receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void allgatherv(const T *send_data, const contiguous_layout<T> &sendl, T *recv_data,
+                    const contiguous_layouts<T> &recvls,
+                    const displacements &recvdispls) const {
+#if defined MPL_DEBUG
+      if (static_cast<int>(recvls.size()) != size_ or
+          static_cast<int>(recvdispls.size()) != size_)
+        throw invalid_size();
+#endif
+      const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+      // data of all processes in node-major order without gaps
+      std::vector<int> offsets(size_ + 1, 0);
+      for (int i{0}; i < size_; ++i)
+        offsets[i + 1] = offsets[i] + static_cast<int>(recvls[node_major_ranks_[i]].size());
+      std::vector<T> node_major_data(offsets.back());
+      const int node_begin{node_offsets_[node()]};
+      if (is_leader()) {
+        std::vector<int> counts(node_comm_.size());
+        std::vector<int> displs(node_comm_.size());
+        for (int i{0}; i < node_comm_.size(); ++i) {
+          counts[i] = offsets[node_begin + i + 1] - offsets[node_begin + i];
+          displs[i] = offsets[node_begin + i] - offsets[node_begin];
+        }
+        MPI_Gatherv(send_data, static_cast<int>(sendl.size()), datatype,
+                    node_major_data.data() + offsets[node_begin], counts.data(), displs.data(),
+                    datatype, 0, node_comm_.native_handle());
+        std::vector<int> node_counts(num_nodes());
+        std::vector<int> node_displs(num_nodes());
+        for (int i{0}; i < num_nodes(); ++i) {
+          node_counts[i] = offsets[node_offsets_[i + 1]] - offsets[node_offsets_[i]];
+          node_displs[i] = offsets[node_offsets_[i]];
+        }
+        if (has_remote_nodes())
+          MPI_Allgatherv(MPI_IN_PLACE, 0, datatype, node_major_data.data(),
+                         node_counts.data(), node_displs.data(), datatype,
+                         leader_comm_.native_handle());
+      } else
+        MPI_Gatherv(send_data, static_cast<int>(sendl.size()), datatype, nullptr, nullptr,
+                    nullptr, datatype, 0, node_comm_.native_handle());
+      MPI_Bcast(node_major_data.data(), offsets.back(), datatype, 0,
+                node_comm_.native_handle());
+      for (int i{0}; i < size_; ++i)
+        std::copy(node_major_data.data() + offsets[i], node_major_data.data() + offsets[i + 1],
+                  displaced(recv_data, recvdispls[node_major_ranks_[i]]));
+    }
+
+    // === allreduce ===
+    /// Performs a reduction operation over all processes and broadcasts the result.
+    /// \tparam F type representing the reduction operation, reduction operation is performed
+    /// on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param f reduction operation
+    /// \param send_data input data for the reduction operation
+    /// \param recv_data will hold the result of the reduction operation
+    /// \note This is a collective operation and must be called by all processes.  Data is
+    /// reduced within nodes first, the reduction operation must be commutative unless the
+    /// processes of each node have consecutive ranks.
+    template<typename T, typename F>
+    void allreduce(F f, const T &send_data, T &recv_data) const {
+      node_comm_.reduce(f, 0, send_data, recv_data);
+      if (has_remote_nodes())
+        leader_comm_.allreduce(f, recv_data);
+      node_comm_.bcast(0, recv_data);
+    }
+
+    /// Performs an element-wise reduction operation over all processes and broadcasts the
+    /// result.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation
+    /// is performed on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param f reduction operation
+    /// \param send_data input data for the reduction operation
+    /// \param recv_data will hold the results of the reduction operation
+    /// \param l memory layouts of the data to send and to receive
+    /// \note This is a collective operation and must be called by all processes.  Data is
+    /// reduced within nodes first, the reduction operation must be commutative unless the
+    /// processes of each node have consecutive ranks.
+    template<typename T, typename F>
+    void allreduce(F f, const T *send_data, T *recv_data, const contiguous_layout<T> &l) const {
+      node_comm_.reduce(f, 0, send_data, recv_data, l);
+      if (has_remote_nodes())
+        leader_comm_.allreduce(f, recv_data, l);
+      node_comm_.bcast(0, recv_data, l);
+    }
+  };
+
+}  // namespace mpl
+
+#endif
@@ -10,6 +10,11 @@
 #include <limits>
 #include <utility>
 #include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 
@@ -74,18 +79,176 @@ namespace mpl {
 
   //--------------------------------------------------------------------
 
+  /// Statistics of the process-wide layout cache.
+  /// \see \c environment::enable_layout_cache
+  struct layout_cache_statistics {
+    /// number of layouts that were constructed from a cached data type
+    std::size_t hits{0};
+    /// number of layouts that were constructed while the cache was enabled and that required
+    /// the creation of a new data type
+    std::size_t misses{0};
+    /// number of data types currently held by the cache
+    std::size_t live_types{0};
+    /// number of data types that were dropped from the cache to stay within its capacity
+    std::size_t evictions{0};
+  };
+
+  namespace detail {
+
+    // owns a committed MPI data type, which may be shared by several layouts
+    class datatype_handle {
+      MPI_Datatype type_{MPI_DATATYPE_NULL};
+
+    public:
+      explicit datatype_handle(MPI_Datatype type) : type_{type} {
+        if (type_ != MPI_DATATYPE_NULL)
+          MPI_Type_commit(&type_);
+      }
+
+      datatype_handle(const datatype_handle &) = delete;
+
+      void operator=(const datatype_handle &) = delete;
+
+      ~datatype_handle() {
+        int finalized{0};
+        MPI_Finalized(&finalized);
+        if (type_ != MPI_DATATYPE_NULL and finalized == 0)
+          MPI_Type_free(&type_);
+      }
+
+      [[nodiscard]] MPI_Datatype get() const {
+        return type_;
+      }
+    };
+
+    using shared_datatype = std::shared_ptr<const datatype_handle>;
+
+    enum class layout_kind : MPI_Aint { vector, strided_vector, indexed_block, subarray };
+
+    // Process-wide cache of the data types of layouts.  Layouts of the same kind with equal
+    // parameters and equal base type share a single committed data type while caching is
+    // enabled.  The cache holds at most a given number of data types, least recently used
+    // ones are dropped first.  Dropped data types are freed as soon as no layout refers to
+    // them anymore.
+    class layout_cache {
+      using key_type = std::vector<MPI_Aint>;
+      using entry_list = std::list<std::pair<key_type, shared_datatype>>;
+
+      mutable std::mutex mutex_;
+      std::atomic<bool> enabled_{false};
+      std::size_t capacity_{0};
+      entry_list entries_;  // most recently used entries first
+      std::map<key_type, entry_list::iterator> index_;
+      layout_cache_statistics statistics_;
+
+      void shrink(std::size_t size) {
+        while (entries_.size() > size) {
+          index_.erase(entries_.back().first);
+          entries_.pop_back();
+          ++statistics_.evictions;
+        }
+      }
+
+    public:
+      layout_cache() = default;
+
+      layout_cache(const layout_cache &) = delete;
+
+      void operator=(const layout_cache &) = delete;
+
+      void enable(std::size_t capacity) {
+        std::lock_guard lock{mutex_};
+        capacity_ = capacity;
+        shrink(capacity_);
+        enabled_ = true;
+      }
+
+      void disable() {
+        std::lock_guard lock{mutex_};
+        enabled_ = false;
+        index_.clear();
+        entries_.clear();
+      }
+
+      [[nodiscard]] bool is_enabled() const {
+        return enabled_;
+      }
+
+      [[nodiscard]] layout_cache_statistics statistics() const {
+        std::lock_guard lock{mutex_};
+        layout_cache_statistics statistics{statistics_};
+        statistics.live_types = entries_.size();
+        return statistics;
+      }
+
+      // Returns the data type of a layout of the given kind, parameters and base type.  The
+      // data type is created by calling build if it is not found in the cache.  The base type
+      // must be a data type that lives until the end of the program.
+      template<typename F>
+      shared_datatype get(layout_kind kind, MPI_Datatype old_type, key_type &&parameters,
+                          F build) {
+        if (not enabled_)
+          return std::make_shared<const datatype_handle>(build());
+        parameters.push_back(static_cast<MPI_Aint>(kind));
+        parameters.push_back(static_cast<MPI_Aint>(MPI_Type_c2f(old_type)));
+        std::lock_guard lock{mutex_};
+        if (auto i{index_.find(parameters)}; i != index_.end()) {
+          entries_.splice(entries_.begin(), entries_, i->second);
+          ++statistics_.hits;
+          return i->second->second;
+        }
+        ++statistics_.misses;
+        auto type{std::make_shared<const datatype_handle>(build())};
+        if (capacity_ > 0) {
+          shrink(capacity_ - 1);
+          entries_.emplace_front(parameters, type);
+          index_.emplace(std::move(parameters), entries_.begin());
+        }
+        return type;
+      }
+    };
+
+    inline layout_cache &get_layout_cache() {
+      static layout_cache cache;
+      return cache;
+    }
+
+  }  // namespace detail
+
+  //--------------------------------------------------------------------
+
   /// Base class for a family of classes that describe where objects are located in
   /// memory when several objects of the same type T are exchanged in a single message.
   /// \tparam T type of the objects that the layout refers to (the base element type)
   template<typename T>
   class layout {
   private:
+    // The committed data type is immutable and shared by all copies of a layout, it is freed
+    // when the last layout referring to it is destroyed.  The raw handle is kept for fast
+    // access.
     MPI_Datatype type_{MPI_DATATYPE_NULL};
+    detail::shared_datatype shared_type_;
+
+    void free() {
+      shared_type_.reset();
+      type_ = MPI_DATATYPE_NULL;
+    }
+
+    void copy(const layout &l) {
+      shared_type_ = l.shared_type_;
+      type_ = l.type_;
+    }
 
   protected:
-    explicit layout(MPI_Datatype new_type) : type_{new_type} {
-      if (type_ != MPI_DATATYPE_NULL)
-        MPI_Type_commit(&type_);
+    explicit layout(MPI_Datatype new_type) {
+      if (new_type != MPI_DATATYPE_NULL) {
+        shared_type_ = std::make_shared<const detail::datatype_handle>(new_type);
+        type_ = shared_type_->get();
+      }
+    }
+
+    explicit layout(detail::shared_datatype new_type)
+        : type_{new_type->get()}, shared_type_{std::move(new_type)} {
     }
 
   public:
@@ -95,15 +258,16 @@ namespace mpl {
     /// Copy constructor creates a new layout that describes the same memory layout as
     /// the other one.
     /// \param l the layout to copy from
+    /// \note Copying a layout is cheap, the underlying MPI data type is shared and not
+    /// duplicated.
     layout(const layout &l) {
-      if (l.type_ != MPI_DATATYPE_NULL)
-        MPI_Type_dup(l.type_, &type_);
+      copy(l);
     }
 
     /// Move constructor creates a new layout that describes the same memory layout as
     /// the other one.
     /// \param l the layout to move from
-    layout(layout &&l) noexcept : type_{l.type_} {
+    layout(layout &&l) noexcept : type_{l.type_}, shared_type_{std::move(l.shared_type_)} {
       l.type_ = MPI_DATATYPE_NULL;
     }
 
@@ -112,12 +276,8 @@ namespace mpl {
     /// \param l the layout to copy from
     layout &operator=(const layout &l) {
       if (this != &l) {
-        if (type_ != MPI_DATATYPE_NULL)
-          MPI_Type_free(&type_);
-        if (l.type_ != MPI_DATATYPE_NULL)
-          MPI_Type_dup(l.type_, &type_);
-        else
-          type_ = MPI_DATATYPE_NULL;
+        free();
+        copy(l);
       }
       return *this;
     }
@@ -126,10 +286,12 @@ namespace mpl {
     /// layout as the other one.
     /// \param l the layout to move from
     layout &operator=(layout &&l) noexcept {
-      if (type_ != MPI_DATATYPE_NULL)
-        MPI_Type_free(&type_);
-      type_ = l.type_;
-      l.type_ = MPI_DATATYPE_NULL;
+      if (this != &l) {
+        free();
+        type_ = l.type_;
+        shared_type_ = std::move(l.shared_type_);
+        l.type_ = MPI_DATATYPE_NULL;
+      }
       return *this;
     }
 
@@ -306,9 +468,9 @@ namespace mpl {
       if (type_ != MPI_DATATYPE_NULL) {
         MPI_Datatype newtype;
         MPI_Type_create_resized(type_, lb, extent, &newtype);
-        MPI_Type_commit(&newtype);
-        MPI_Type_free(&type_);
-        type_ = newtype;
+        free();
+        shared_type_ = std::make_shared<const detail::datatype_handle>(newtype);
+        type_ = shared_type_->get();
       }
     }
 
@@ -325,12 +487,12 @@ namespace mpl {
     /// \param l other layout
     void swap(layout &l) noexcept {
       std::swap(type_, l.type_);
+      std::swap(shared_type_, l.shared_type_);
     }
 
     /// Destroy layout.
     ~layout() {
-      if (type_ != MPI_DATATYPE_NULL)
-        MPI_Type_free(&type_);
+      free();
     }
 
     friend class detail::datatype_traits<layout>;
@@ -445,7 +607,7 @@ namespace mpl {
     /// exchanges two empty layouts
     /// \param other the layout to swap with
     void swap(empty_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -554,7 +716,7 @@ namespace mpl {
     /// exchanges two contiguous layouts
     /// \param other the layout to swap with
     void swap(contiguous_layout&other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
       std::swap(count_, other.count_);
     }
 
@@ -568,6 +730,8 @@ namespace mpl {
     friend class impl::base_communicator;
     friend class communicator;
     friend class inter_communicator;
+    friend class hierarchical_communicator;
+    friend class tuned_communicator;
     friend class contiguous_layouts<T>;
   };
 
@@ -614,7 +778,12 @@ namespace mpl {
   public:
     /// constructs layout for contiguous storage several objects of type T
     /// \param count number of objects
-    explicit vector_layout(size_t count = 0) : layout<T>(build(count)) {
+    /// \note The underlying data type is taken from the layout cache if enabled.
+    /// \see \c environment::enable_layout_cache
+    explicit vector_layout(size_t count = 0)
+        : layout<T>(detail::get_layout_cache().get(
+              detail::layout_kind::vector, detail::datatype_traits<T>::get_datatype(),
+              {static_cast<MPI_Aint>(count)}, [count]() { return build(count); })) {
     }
 
     /// constructs layout for data with memory layout that is a homogenous sequence of some
@@ -648,7 +817,7 @@ namespace mpl {
     /// exchanges two contiguous layouts
     /// \param other the layout to swap with
     void swap(vector_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -671,12 +840,6 @@ namespace mpl {
   class strided_vector_layout : public layout<T> {
     using layout<T>::type_;
 
-    static MPI_Datatype build() {
-      MPI_Datatype new_type;
-      MPI_Type_contiguous(0, detail::datatype_traits<T>::get_datatype(), &new_type);
-      return new_type;
-    }
-
     static MPI_Datatype build(
         int count, int blocklength, int stride,
         MPI_Datatype old_type = detail::datatype_traits<T>::get_datatype()) {
@@ -687,15 +850,20 @@ namespace mpl {
 
   public:
     /// constructs a layout with no data
-    strided_vector_layout() : layout<T>(build()) {
+    strided_vector_layout() : strided_vector_layout(0, 0, 0) {
     }
 
     /// constructs a layout with several strided objects of type T
     /// \param count the number of blocks (non-negative)
     /// \param blocklength number of data elements in each block (non-negative)
     /// \param stride number or elements between start of each block
+    /// \note The underlying data type is taken from the layout cache if enabled.
+    /// \see \c environment::enable_layout_cache
     explicit strided_vector_layout(int count, int blocklength, int stride)
-        : layout<T>(build(count, blocklength, stride)) {
+        : layout<T>(detail::get_layout_cache().get(
+              detail::layout_kind::strided_vector, detail::datatype_traits<T>::get_datatype(),
+              {count, blocklength, stride},
+              [=]() { return build(count, blocklength, stride); })) {
     }
 
     /// constructs a layout with several strided objects of some other layout
@@ -731,7 +899,7 @@ namespace mpl {
     /// exchanges two contiguous layouts
     /// \param other the layout to swap with
     void swap(strided_vector_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -850,7 +1018,7 @@ namespace mpl {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(indexed_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -977,7 +1145,7 @@ namespace mpl {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(hindexed_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -1036,12 +1204,6 @@ namespace mpl {
     };
 
   private:
-    static MPI_Datatype build() {
-      MPI_Datatype new_type;
-      MPI_Type_contiguous(0, detail::datatype_traits<T>::get_datatype(), &new_type);
-      return new_type;
-    }
-
     static MPI_Datatype build(
         int blocklengths, const parameter &par,
         MPI_Datatype old_type = detail::datatype_traits<T>::get_datatype()) {
@@ -1051,17 +1213,27 @@ namespace mpl {
       return new_type;
     }
 
+    static std::vector<MPI_Aint> key(int blocklength, const parameter &par) {
+      std::vector<MPI_Aint> key{blocklength};
+      key.insert(key.end(), par.displacements.begin(), par.displacements.end());
+      return key;
+    }
+
   public:
     /// constructs a layout with no data
-    indexed_block_layout() : layout<T>(build()) {
+    indexed_block_layout() : indexed_block_layout(0, parameter()) {
     }
 
     /// constructs indexed layout for data of type T
     /// \param blocklength the length of each block
     /// \param par parameter containing information about the layout
     /// \note displacements are given in multiples of the extent of \c T
+    /// \note The underlying data type is taken from the layout cache if enabled.
+    /// \see \c environment::enable_layout_cache
     explicit indexed_block_layout(int blocklength, const parameter &par)
-        : layout<T>(build(blocklength, par)) {
+        : layout<T>(detail::get_layout_cache().get(
+              detail::layout_kind::indexed_block, detail::datatype_traits<T>::get_datatype(),
+              key(blocklength, par), [&]() { return build(blocklength, par); })) {
     }
 
     /// constructs indexed layout for data with some other layout
@@ -1096,7 +1268,7 @@ namespace mpl {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(indexed_block_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -1220,7 +1392,7 @@ namespace mpl {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(hindexed_block_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -1374,7 +1546,7 @@ namespace mpl {
     /// exchanges two iterator layouts
     /// \param other the layout to swap with
     void swap(iterator_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -1489,14 +1661,27 @@ namespace mpl {
       return new_type;
     }
 
+    static std::vector<MPI_Aint> key(const parameter &par) {
+      std::vector<MPI_Aint> key{static_cast<MPI_Aint>(par.order())};
+      key.insert(key.end(), par.sizes.begin(), par.sizes.end());
+      key.insert(key.end(), par.subsizes.begin(), par.subsizes.end());
+      key.insert(key.end(), par.starts.begin(), par.starts.end());
+      return key;
+    }
+
   public:
     /// constructs a layout with no data
-    subarray_layout() : layout<T>(build()) {
+    subarray_layout() : subarray_layout(parameter()) {
     }
 
     /// constructs subarray layout for data of type T
     /// \param par parameter containing information about the layout
-    explicit subarray_layout(const parameter &par) : layout<T>(build(par)) {
+    /// \note The underlying data type is taken from the layout cache if enabled.
+    /// \see \c environment::enable_layout_cache
+    explicit subarray_layout(const parameter &par)
+        : layout<T>(detail::get_layout_cache().get(
+              detail::layout_kind::subarray, detail::datatype_traits<T>::get_datatype(),
+              key(par), [&]() { return build(par); })) {
     }
 
     /// constructs subarray layout for data with some other layout
@@ -1529,7 +1714,7 @@ namespace mpl {
     /// exchanges two subarray layouts
     /// \param other the layout to swap with
     void swap(subarray_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<T>::swap(other);
     }
 
     using layout<T>::byte_extent;
@@ -1705,7 +1890,7 @@ namespace mpl {
     /// exchanges two heterogeneous layouts
     /// \param other the layout to swap with
     void swap(heterogeneous_layout &other) noexcept {
-      std::swap(type_, other.type_);
+      layout<void>::swap(other);
     }
 
     using layout<void>::byte_extent;
@@ -1794,8 +1979,12 @@ namespace mpl {
     friend class communicator;
 
   private:
-    const layout<T> *operator()() const {
-      return base::data();
+    [[nodiscard]] std::vector<MPI_Datatype> datatypes() const {
+      std::vector<MPI_Datatype> types;
+      types.reserve(size());
+      std::transform(begin(), end(), std::back_inserter(types),
+                     [](const layout<T> &l) { return l.native_handle(); });
+      return types;
     }
   };
 
@@ -1831,6 +2020,7 @@ namespace mpl {
 
     friend class impl::base_communicator;
     friend class impl::topology_communicator;
+    friend class tuned_communicator;
 
   private:
     const contiguous_layout<T> *operator()() const {
@@ -52,8 +52,10 @@ namespace mpl {
 #include <mpl/layout.hpp>
 #include <mpl/status.hpp>
 #include <mpl/message.hpp>
-#include <mpl/operator.hpp>
 #include <mpl/request.hpp>
+#include <mpl/operator.hpp>
+#include <mpl/serialization.hpp>
+#include <mpl/packed_message.hpp>
 #include <mpl/info.hpp>
 #include <mpl/comm_group.hpp>
 #include <mpl/environment.hpp>
@@ -63,5 +65,7 @@ namespace mpl {
 #include <mpl/file.hpp>
 #include <mpl/distributed_graph_communicator.hpp>
 #include <mpl/distributed_grid.hpp>
+#include <mpl/hierarchical_communicator.hpp>
+#include <mpl/tuned_communicator.hpp>
 
 #endif
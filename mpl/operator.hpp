@@ -3,14 +3,94 @@
 #define MPL_OPERATOR_HPP
 
 #include <mpi.h>
+#include <array>
+#include <atomic>
+#include <complex>
+#include <cstddef>
 #include <functional>
+#include <tuple>
 #include <type_traits>
 #include <memory>
+#include <utility>
+#include <optional>
+#include <thread>
 #include <ciso646>
+#include <mpl/utility.hpp>
+#include <mpl/datatype.hpp>
+#include <mpl/request.hpp>
 
 
 namespace mpl {
 
+  namespace detail {
+
+    // aggregates of arithmetic types, arithmetic operations on such types are carried out
+    // component-wise
+    template<typename T>
+    inline constexpr bool is_arithmetic_aggregate_v{false};
+
+    template<typename T, std::size_t N>
+    inline constexpr bool is_arithmetic_aggregate_v<std::array<T, N>>{std::is_arithmetic_v<T>};
+
+    template<typename T1, typename T2>
+    inline constexpr bool is_arithmetic_aggregate_v<std::pair<T1, T2>>{
+        std::is_arithmetic_v<T1> and std::is_arithmetic_v<T2>};
+
+    template<typename... Ts>
+    inline constexpr bool is_arithmetic_aggregate_v<std::tuple<Ts...>>{
+        (std::is_arithmetic_v<Ts> and ...)};
+
+    template<typename T, typename F, std::size_t... I>
+    T componentwise(const T &x, const T &y, F f, std::index_sequence<I...>) {
+      return T{static_cast<std::tuple_element_t<I, T>>(f(std::get<I>(x), std::get<I>(y)))...};
+    }
+
+    template<typename T, std::size_t N, typename F>
+    std::array<T, N> componentwise(const std::array<T, N> &x, const std::array<T, N> &y,
+                                   F f) {
+      std::array<T, N> res;
+      for (std::size_t i{0}; i < N; ++i)
+        res[i] = static_cast<T>(f(x[i], y[i]));
+      return res;
+    }
+
+    template<typename T, typename F>
+    T componentwise(const T &x, const T &y, F f) {
+      return componentwise(x, y, f, std::make_index_sequence<std::tuple_size_v<T>>());
+    }
+
+  }  // namespace detail
+
+  /// Pair of a value and an integer index, e.g., the rank of a process or the position of the
+  /// value within an array, as used by the reduction operations \ref min_loc and \ref max_loc.
+  /// \tparam T type of the value
+  /// \note The memory layout of \c value_index equals the layout of the pair types of the MPI
+  /// standard.  Thus, \c value_index is mapped to the predefined MPI data types
+  /// \c MPI_FLOAT_INT, \c MPI_DOUBLE_INT, \c MPI_LONG_DOUBLE_INT, \c MPI_LONG_INT,
+  /// \c MPI_2INT and \c MPI_SHORT_INT if \c T is \c float, \c double, <tt>long double</tt>,
+  /// \c long, \c int, or \c short, respectively.
+  template<typename T>
+  struct value_index {
+    /// the value
+    T value;
+    /// the index that is associated with the value
+    int index;
+
+    /// \param x first argument
+    /// \param y second argument
+    /// \return true if values and indices are equal
+    friend bool operator==(const value_index &x, const value_index &y) {
+      return x.value == y.value and x.index == y.index;
+    }
+
+    /// \param x first argument
+    /// \param y second argument
+    /// \return true if values or indices differ
+    friend bool operator!=(const value_index &x, const value_index &y) {
+      return not(x == y);
+    }
+  };
+
   /// Function object for calculating the maximum of two values in reduction operations
   /// as <tt>communicator::reduce</tt>.
   /// \tparam T data type of the reduction operation's arguments and its result
@@ -40,26 +120,36 @@ namespace mpl {
   /// Function object for calculating the sum of two values in reduction operations as
   /// communicator::reduce.
   /// \tparam T data type of the reduction operation's arguments and its result
+  /// \note Sums of \c std::array, \c std::pair and \c std::tuple objects with arithmetic
+  /// components are calculated component-wise.
   template<typename T>
   struct plus {
     /// \param x first argument
     /// \param y second argument
     /// \return sum of the two arguments
     T operator()(const T &x, const T &y) const {
-      return x + y;
+      if constexpr (detail::is_arithmetic_aggregate_v<T>)
+        return detail::componentwise(x, y, [](const auto &a, const auto &b) { return a + b; });
+      else
+        return x + y;
     }
   };
 
   /// Function object for calculating the product of two values in reduction operations
   /// as <tt>communicator::reduce</tt>.
   /// \tparam T data type of the reduction operation's arguments and its result
+  /// \note Products of \c std::array, \c std::pair and \c std::tuple objects with
+  /// arithmetic components are calculated component-wise.
   template<typename T>
   struct multiplies {
     /// \param x first argument
     /// \param y second argument
     /// \return product of the two arguments
     T operator()(const T &x, const T &y) const {
-      return x * y;
+      if constexpr (detail::is_arithmetic_aggregate_v<T>)
+        return detail::componentwise(x, y, [](const auto &a, const auto &b) { return a * b; });
+      else
+        return x * y;
     }
   };
 
@@ -141,6 +231,50 @@ namespace mpl {
     }
   };
 
+  /// Function object for calculating the minimum of two values and its associated index in
+  /// reduction operations as <tt>communicator::reduce</tt>.  If both values are equal, the
+  /// smaller index is selected.
+  /// \tparam T type of the values, the reduction operation's arguments and its result are of
+  /// type <tt>value_index<T></tt>
+  /// \note For the value types \c float, \c double, <tt>long double</tt>, \c long, \c int,
+  /// and \c short, this reduction operation is mapped to the predefined MPI reduction
+  /// operation \c MPI_MINLOC.
+  template<typename T>
+  struct min_loc {
+    /// \param x first argument
+    /// \param y second argument
+    /// \return argument with the smaller value
+    value_index<T> operator()(const value_index<T> &x, const value_index<T> &y) const {
+      if (x.value < y.value)
+        return x;
+      if (y.value < x.value)
+        return y;
+      return x.index < y.index ? x : y;
+    }
+  };
+
+  /// Function object for calculating the maximum of two values and its associated index in
+  /// reduction operations as <tt>communicator::reduce</tt>.  If both values are equal, the
+  /// smaller index is selected.
+  /// \tparam T type of the values, the reduction operation's arguments and its result are of
+  /// type <tt>value_index<T></tt>
+  /// \note For the value types \c float, \c double, <tt>long double</tt>, \c long, \c int,
+  /// and \c short, this reduction operation is mapped to the predefined MPI reduction
+  /// operation \c MPI_MAXLOC.
+  template<typename T>
+  struct max_loc {
+    /// \param x first argument
+    /// \param y second argument
+    /// \return argument with the larger value
+    value_index<T> operator()(const value_index<T> &x, const value_index<T> &y) const {
+      if (y.value < x.value)
+        return x;
+      if (x.value < y.value)
+        return y;
+      return x.index < y.index ? x : y;
+    }
+  };
+
   // -------------------------------------------------------------------
 
   /// Traits class for storing meta information about reduction operations.
@@ -231,19 +365,252 @@ namespace mpl {
     static constexpr bool is_commutative = true;
   };
 
+  /// Specialization of traits class \c op_traits for storing meta information about
+  /// the \c min_loc reduction operation.
+  template<typename T>
+  struct op_traits<min_loc<T>> {
+    /// The <tt>\ref min_loc</tt> reduction operation is commutative.
+    static constexpr bool is_commutative = true;
+  };
+
+  /// Specialization of traits class \c op_traits for storing meta information about
+  /// the \c max_loc reduction operation.
+  template<typename T>
+  struct op_traits<max_loc<T>> {
+    /// The <tt>\ref max_loc</tt> reduction operation is commutative.
+    static constexpr bool is_commutative = true;
+  };
+
+  // -------------------------------------------------------------------
+
+  /// Specialization of \c struct_builder for value-index pairs.
+  /// \tparam T type of the value
+  /// \see class \c struct_builder
+  template<typename T>
+  class struct_builder<value_index<T>> : public base_struct_builder<value_index<T>> {
+    using base = base_struct_builder<value_index<T>>;
+    struct_layout<value_index<T>> layout_;
+
+  public:
+    struct_builder() {
+      value_index<T> pair;
+      layout_.register_struct(pair);
+      layout_.register_element(pair.value);
+      layout_.register_element(pair.index);
+      base::define_struct(layout_);
+    }
+  };
+
   // -------------------------------------------------------------------
 
   namespace detail {
 
+    // type classes as used by the MPI standard to specify the types that predefined reduction
+    // operations can be applied to, types that MPL maps to MPI_CHAR or MPI_WCHAR are excluded
+    template<typename T>
+    inline constexpr bool is_mpi_integer_v{std::is_integral_v<T> and
+                                           not std::is_same_v<T, bool> and
+                                           not std::is_same_v<T, char> and
+                                           not std::is_same_v<T, wchar_t>};
+
+    template<typename T>
+    inline constexpr bool is_mpi_floating_point_v{std::is_floating_point_v<T>};
+
+    template<typename T>
+    inline constexpr bool is_mpi_complex_v{false};
+
+    template<typename T>
+    inline constexpr bool is_mpi_complex_v<std::complex<T>>{std::is_floating_point_v<T>};
+
+    template<typename T>
+    inline constexpr bool is_mpi_logical_v{std::is_same_v<T, bool>};
+
+    template<typename T>
+    inline constexpr bool is_mpi_byte_v{std::is_same_v<T, std::byte>};
+
+    // value types of value_index that have a predefined MPI pair data type
+    template<typename T>
+    inline constexpr bool is_mpi_pair_value_v{
+        std::is_same_v<T, float> or std::is_same_v<T, double> or
+        std::is_same_v<T, long double> or std::is_same_v<T, long> or std::is_same_v<T, int> or
+        std::is_same_v<T, short>};
+
+    template<typename T>
+    MPI_Datatype get_mpi_pair_datatype() {
+      if constexpr (std::is_same_v<T, float>)
+        return MPI_FLOAT_INT;
+      else if constexpr (std::is_same_v<T, double>)
+        return MPI_DOUBLE_INT;
+      else if constexpr (std::is_same_v<T, long double>)
+        return MPI_LONG_DOUBLE_INT;
+      else if constexpr (std::is_same_v<T, long>)
+        return MPI_LONG_INT;
+      else if constexpr (std::is_same_v<T, int>)
+        return MPI_2INT;
+      else
+        return MPI_SHORT_INT;
+    }
+
+    template<typename T>
+    class datatype_traits<value_index<T>> {
+    public:
+      static MPI_Datatype get_datatype() {
+        if constexpr (is_mpi_pair_value_v<T>)
+          return get_mpi_pair_datatype<T>();
+        else
+          return datatype_traits_impl<value_index<T>>::get_datatype();
+      }
+      using data_type_category = detail::basic_or_fixed_size_type;
+    };
+
+    // Maps a reduction operation F on type T to an equivalent predefined MPI reduction
+    // operation if there is one.  Predefined operations allow the MPI implementation to use
+    // optimized or hardware-offloaded reduction algorithms.
+    template<typename T, typename F>
+    struct builtin_op {
+      static constexpr bool is_available{false};
+    };
+
+    template<typename T>
+    struct builtin_op<T, max<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_floating_point_v<T>};
+      static MPI_Op get() {
+        return MPI_MAX;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, min<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_floating_point_v<T>};
+      static MPI_Op get() {
+        return MPI_MIN;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, plus<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_floating_point_v<T> or
+                                         is_mpi_complex_v<T>};
+      static MPI_Op get() {
+        return MPI_SUM;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, multiplies<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_floating_point_v<T> or
+                                         is_mpi_complex_v<T>};
+      static MPI_Op get() {
+        return MPI_PROD;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, logical_and<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_logical_v<T>};
+      static MPI_Op get() {
+        return MPI_LAND;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, logical_or<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_logical_v<T>};
+      static MPI_Op get() {
+        return MPI_LOR;
+      }
+    };
+
+    // logical_xor is implemented via the xor operator, which is a bitwise operation for
+    // integers, thus, it is equivalent to MPI_LXOR for booleans only
+    template<typename T>
+    struct builtin_op<T, logical_xor<T>> {
+      static constexpr bool is_available{is_mpi_logical_v<T>};
+      static MPI_Op get() {
+        return MPI_LXOR;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, bit_and<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_byte_v<T>};
+      static MPI_Op get() {
+        return MPI_BAND;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, bit_or<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_byte_v<T>};
+      static MPI_Op get() {
+        return MPI_BOR;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<T, bit_xor<T>> {
+      static constexpr bool is_available{is_mpi_integer_v<T> or is_mpi_byte_v<T>};
+      static MPI_Op get() {
+        return MPI_BXOR;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<value_index<T>, min_loc<T>> {
+      static constexpr bool is_available{is_mpi_pair_value_v<T>};
+      static MPI_Op get() {
+        return MPI_MINLOC;
+      }
+    };
+
+    template<typename T>
+    struct builtin_op<value_index<T>, max_loc<T>> {
+      static constexpr bool is_available{is_mpi_pair_value_v<T>};
+      static MPI_Op get() {
+        return MPI_MAXLOC;
+      }
+    };
+
+    // Reduction kernels apply a reduction operation to the elements of an input buffer and an
+    // input-output buffer.  User-defined function objects may provide a bulk overload
+    //   void operator()(const T *in, T *in_out, int n)
+    // that performs in_out[i] = f(in[i], in_out[i]) for all 0 <= i < n, e.g., via SIMD
+    // instructions.  Otherwise, the binary function object is applied element by element.
+    // The function object is accessed via a local reference such that the compiler can inline
+    // its call operator and vectorize the loop.
+    template<typename T, typename F, typename = void>
+    struct has_bulk_apply : std::false_type {};
+
+    template<typename T, typename F>
+    struct has_bulk_apply<T, F,
+                          std::void_t<decltype(get_object<F &>()(
+                              get_object<const T *>(), get_object<T *>(), get_object<int>()))>>
+        : std::true_type {};
+
+    template<typename T, typename F>
+    inline constexpr bool has_bulk_apply_v{has_bulk_apply<T, F>::value};
+
+    template<typename T, typename F>
+    void reduction_kernel(F &f, const T *in, T *in_out, int n) {
+      if constexpr (has_bulk_apply_v<T, F>)
+        f(in, in_out, n);
+      else
+        for (int i{0}; i < n; ++i)
+          in_out[i] = f(in[i], in_out[i]);
+    }
+
     template<typename T, typename F>
     class op;
 
     template<typename T, typename F>
-    inline op<T, F> &get_op(F f) {
+    inline op<T, F> &get_static_op(F f) {
       static op<T, F> op_(f);
       return op_;
     }
 
+    // Reduction operation that is shared by all reductions on type T with function objects
+    // of type F, used for predefined reduction operations and for function objects without
+    // state only.
     template<typename T, typename F>
     class op {
     public:
@@ -254,14 +621,14 @@ namespace mpl {
       static_assert(not std::is_pointer_v<F>, "functor must not be function pointer");
 
       static constexpr bool is_commutative = op_traits<functor>::is_commutative;
+      static constexpr bool is_builtin = builtin_op<T, functor>::is_available;
       static std::unique_ptr<functor> f;
 
       static void apply(void *in_vector, void *in_out_vector, int *len,
                         [[maybe_unused]] MPI_Datatype *datatype) {
-        auto *i_1{static_cast<T *>(in_vector)};
-        auto *i_2{static_cast<T *>(in_out_vector)};
-        for (int i{0}, i_end{*len}; i < i_end; ++i, ++i_1, ++i_2)
-          *i_2 = (*f)(*i_1, *i_2);
+        F &f_{*f};
+        reduction_kernel(f_, static_cast<const T *>(in_vector), static_cast<T *>(in_out_vector),
+                         *len);
       }
 
       MPI_Op mpi_op{MPI_OP_NULL};
@@ -269,24 +636,175 @@ namespace mpl {
     private:
       explicit op(F f_) {
         f.reset(new F(f_));
-        MPI_Op_create(op::apply, is_commutative, &mpi_op);
+        if constexpr (is_builtin)
+          mpi_op = builtin_op<T, functor>::get();
+        else
+          MPI_Op_create(op::apply, is_commutative, &mpi_op);
       }
 
     public:
       op(op const &) = delete;
 
       ~op() {
-        MPI_Op_free(&mpi_op);
+        if constexpr (not is_builtin)
+          MPI_Op_free(&mpi_op);
       }
 
       void operator=(op const &) = delete;
 
-      friend op &get_op<>(F);
+      friend op &get_static_op<>(F);
     };
 
     template<typename T, typename F>
     std::unique_ptr<F> op<T, F>::f;
 
+    //------------------------------------------------------------------
+
+    template<typename T, typename F>
+    class op_pool;
+
+    template<typename T, typename F>
+    inline op_pool<T, F> &get_op_pool() {
+      static op_pool<T, F> pool;
+      return pool;
+    }
+
+    // Pool of reduction operations for function objects with state.  The user function of
+    // an MPI reduction operation gets no user data, thus, each slot of the pool has its own
+    // user function, which applies the function object stored in this slot.  A slot is held
+    // by a single reduction for the reduction's duration such that concurrent reductions
+    // with different function objects of the same type do not interfere.  The MPI reduction
+    // operation of a slot is created on its first use and reused subsequently.
+    template<typename T, typename F>
+    class op_pool {
+    public:
+      static constexpr std::size_t capacity{64};
+
+    private:
+      static_assert(is_binary_functor<T, F>::value or has_bulk_apply_v<T, F>,
+                    "reduction operator must be a binary function");
+      static_assert(not std::is_pointer_v<F>, "functor must not be function pointer");
+
+      struct slot {
+        std::atomic<bool> in_use{false};
+        std::optional<F> f;
+        MPI_Op mpi_op{MPI_OP_NULL};
+      };
+
+      std::array<slot, capacity> slots_;
+
+      template<std::size_t I>
+      static void apply(void *in_vector, void *in_out_vector, int *len,
+                        [[maybe_unused]] MPI_Datatype *datatype) {
+        F &f{*get_op_pool<T, F>().slots_[I].f};
+        reduction_kernel(f, static_cast<const T *>(in_vector), static_cast<T *>(in_out_vector),
+                         *len);
+      }
+
+      template<std::size_t... I>
+      static MPI_User_function *user_function(std::size_t i, std::index_sequence<I...>) {
+        static constexpr MPI_User_function *functions[]{&apply<I>...};
+        return functions[i];
+      }
+
+      op_pool() = default;
+
+    public:
+      op_pool(const op_pool &) = delete;
+
+      ~op_pool() {
+        for (auto &s : slots_)
+          if (s.mpi_op != MPI_OP_NULL)
+            MPI_Op_free(&s.mpi_op);
+      }
+
+      void operator=(const op_pool &) = delete;
+
+      /// Acquires a free slot and stores a copy of the function object in it.  Waits for
+      /// other reductions to release their slots if all slots are in use.
+      /// \param f reduction operation
+      /// \return index of the acquired slot
+      std::size_t acquire(F f) {
+        while (true) {
+          for (std::size_t i{0}; i < capacity; ++i) {
+            auto &s{slots_[i]};
+            if (not s.in_use.exchange(true, std::memory_order_acquire)) {
+              s.f.emplace(std::move(f));
+              if (s.mpi_op == MPI_OP_NULL)
+                MPI_Op_create(user_function(i, std::make_index_sequence<capacity>()),
+                              op_traits<F>::is_commutative, &s.mpi_op);
+              return i;
+            }
+          }
+          // pending non-blocking reductions release their slots when they are completed
+          impl::get_progress_engine().progress();
+          std::this_thread::yield();
+        }
+      }
+
+      /// \param i slot index
+      /// \return MPI reduction operation of the slot
+      [[nodiscard]] MPI_Op mpi_op(std::size_t i) const {
+        return slots_[i].mpi_op;
+      }
+
+      /// Releases a slot acquired before.
+      /// \param i slot index
+      void release(std::size_t i) {
+        slots_[i].f.reset();
+        slots_[i].in_use.store(false, std::memory_order_release);
+      }
+
+      friend op_pool &get_op_pool<>();
+    };
+
+    //------------------------------------------------------------------
+
+    // Handle to the reduction operation for a single reduction on type T with the function
+    // object f.  Must be kept alive until the reduction has been completed.
+    template<typename T, typename F>
+    class reduction_op {
+    public:
+      static constexpr bool is_stateful{
+          not(builtin_op<T, F>::is_available or std::is_empty_v<F>)};
+
+      MPI_Op mpi_op{MPI_OP_NULL};
+
+    private:
+      std::size_t slot_{0};
+
+    public:
+      explicit reduction_op(F f) {
+        if constexpr (is_stateful) {
+          auto &pool{get_op_pool<T, F>()};
+          slot_ = pool.acquire(std::move(f));
+          mpi_op = pool.mpi_op(slot_);
+        } else
+          mpi_op = get_static_op<T, F>(f).mpi_op;
+      }
+
+      reduction_op(const reduction_op &) = delete;
+
+      reduction_op(reduction_op &&other) noexcept : mpi_op{other.mpi_op}, slot_{other.slot_} {
+        other.mpi_op = MPI_OP_NULL;
+      }
+
+      ~reduction_op() {
+        if constexpr (is_stateful)
+          if (mpi_op != MPI_OP_NULL)
+            get_op_pool<T, F>().release(slot_);
+      }
+
+      void operator=(const reduction_op &) = delete;
+
+      void operator=(reduction_op &&) = delete;
+    };
+
+    template<typename T, typename F>
+    inline reduction_op<T, F> get_op(F f) {
+      return reduction_op<T, F>(std::move(f));
+    }
+
   }  // namespace detail
 
 }  // namespace mpl
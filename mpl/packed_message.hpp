@@ -0,0 +1,226 @@
+#if !(defined MPL_PACKED_MESSAGE_HPP)
+
+#define MPL_PACKED_MESSAGE_HPP
+
+#include <mpi.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <mpl/datatype.hpp>
+#include <mpl/utility.hpp>
+#include <mpl/layout.hpp>
+#include <mpl/error.hpp>
+
+
+namespace mpl {
+
+  class communicator;
+
+  class inter_communicator;
+
+  namespace impl {
+    class base_communicator;
+  }
+
+  /// Message of heterogeneous data that is packed into a contiguous buffer via
+  /// <tt>MPI_Pack</tt> and transferred as a single message of type <tt>MPI_PACKED</tt>.
+  /// Values are inserted via <tt>operator<<</tt> and extracted in the same order via
+  /// <tt>operator>></tt>.  The buffer of the message is a growable arena that keeps its
+  /// capacity when the message is cleared.  Thus, a packed message may be reused for
+  /// messages of varying shape without further memory allocations.
+  /// \note A packed message is bound to the communicator that it has been created for and
+  /// must be sent and received via this communicator only.
+  class packed_message {
+    MPI_Comm comm_{MPI_COMM_NULL};
+    std::vector<std::byte> arena_;
+    int size_{0};
+    int position_{0};
+
+    int pack_size(int count, MPI_Datatype datatype) const {
+      int bytes{0};
+      MPI_Pack_size(count, datatype, comm_, &bytes);
+      return bytes;
+    }
+
+    void grow(int bytes) {
+#if defined MPL_DEBUG
+      if (bytes > std::numeric_limits<int>::max() - size_)
+        throw invalid_size();
+#endif
+      const std::size_t required{static_cast<std::size_t>(size_) +
+                                 static_cast<std::size_t>(bytes)};
+      if (required > arena_.size())
+        arena_.resize(std::min(std::max(required, 2 * arena_.size()),
+                               static_cast<std::size_t>(std::numeric_limits<int>::max())));
+    }
+
+    void pack_data(const void *data, int count, MPI_Datatype datatype) {
+      grow(pack_size(count, datatype));
+      MPI_Pack(data, count, datatype, arena_.data(), static_cast<int>(arena_.size()), &size_,
+               comm_);
+    }
+
+    void unpack_data(void *data, int count, MPI_Datatype datatype) {
+#if defined MPL_DEBUG
+      if (pack_size(count, datatype) > size_ - position_)
+        throw invalid_size();
+#endif
+      MPI_Unpack(arena_.data(), size_, &position_, data, count, datatype, comm_);
+    }
+
+    // makes the arena large enough to hold a received message of the given size
+    std::byte *prepare_recv(int bytes) {
+      clear();
+      if (static_cast<std::size_t>(bytes) > arena_.size())
+        arena_.resize(bytes);
+      size_ = bytes;
+      return arena_.data();
+    }
+
+  public:
+    /// Creates an empty packed message for a communicator.
+    /// \param comm communicator that is used to transfer the packed message
+    explicit packed_message(const communicator &comm);
+
+    /// Creates an empty packed message for an inter-communicator.
+    /// \param comm inter-communicator that is used to transfer the packed message
+    explicit packed_message(const inter_communicator &comm);
+
+    /// Packs a single value into the message.
+    /// \tparam T type of the value, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section or a contiguous STL
+    /// container, e.g., <tt>std::vector</tt> or <tt>std::string</tt>, that holds elements
+    /// that comply with the mentioned requirements
+    /// \param x value to pack
+    /// \return reference to this packed message (allows chaining)
+    /// \details Contiguous STL containers are packed as their number of elements followed by
+    /// their elements.
+    template<typename T>
+    packed_message &operator<<(const T &x) {
+      using category = typename detail::datatype_traits<T>::data_type_category;
+      if constexpr (std::is_same_v<category, detail::basic_or_fixed_size_type>)
+        pack_data(&x, 1, detail::datatype_traits<T>::get_datatype());
+      else {
+        static_assert(std::is_base_of_v<detail::contiguous_const_stl_container, category>,
+                      "type can not be packed");
+        const std::uint64_t n{x.size()};
+        pack_data(&n, 1, MPI_UINT64_T);
+        pack(std::data(x), static_cast<int>(n));
+      }
+      return *this;
+    }
+
+    /// Unpacks a single value from the message.
+    /// \tparam T type of the value, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section or a resizable
+    /// contiguous STL container, e.g., <tt>std::vector</tt> or <tt>std::string</tt>, that
+    /// holds elements that comply with the mentioned requirements
+    /// \param x value to unpack, previous content is replaced
+    /// \return reference to this packed message (allows chaining)
+    template<typename T>
+    packed_message &operator>>(T &x) {
+      using category = typename detail::datatype_traits<T>::data_type_category;
+      if constexpr (std::is_same_v<category, detail::basic_or_fixed_size_type>)
+        unpack_data(&x, 1, detail::datatype_traits<T>::get_datatype());
+      else {
+        static_assert(std::is_base_of_v<detail::contiguous_const_stl_container, category> and
+                          detail::has_resize_v<T>,
+                      "type can not be unpacked");
+        std::uint64_t n{0};
+        unpack_data(&n, 1, MPI_UINT64_T);
+        x.resize(n);
+        unpack(std::data(x), static_cast<int>(n));
+      }
+      return *this;
+    }
+
+    /// Packs several values into the message.
+    /// \tparam T type of the values, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param data pointer to the values to pack
+    /// \param count number of values to pack
+    template<typename T>
+    void pack(const T *data, int count) {
+      pack_data(data, count, detail::datatype_traits<T>::get_datatype());
+    }
+
+    /// Packs several values having a specific memory layout into the message.
+    /// \tparam T type of the values, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param data pointer to the values to pack
+    /// \param l memory layout of the values to pack
+    template<typename T>
+    void pack(const T *data, const layout<T> &l) {
+      pack_data(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l));
+    }
+
+    /// Unpacks several values from the message.
+    /// \tparam T type of the values, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param data pointer to the memory that the values are unpacked to
+    /// \param count number of values to unpack
+    template<typename T>
+    void unpack(T *data, int count) {
+      unpack_data(data, count, detail::datatype_traits<T>::get_datatype());
+    }
+
+    /// Unpacks several values having a specific memory layout from the message.
+    /// \tparam T type of the values, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param data pointer to the memory that the values are unpacked to
+    /// \param l memory layout of the values to unpack
+    template<typename T>
+    void unpack(T *data, const layout<T> &l) {
+      unpack_data(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l));
+    }
+
+    /// Removes all packed data from the message and resets the read position.  The memory
+    /// of the buffer is retained for reuse.
+    void clear() {
+      size_ = 0;
+      position_ = 0;
+    }
+
+    /// Resets the read position, such that the packed data can be unpacked once more.
+    void rewind() {
+      position_ = 0;
+    }
+
+    /// Makes sure that the buffer of the message can hold at least the given number of bytes
+    /// without further memory allocations.
+    /// \param bytes buffer size in bytes
+    void reserve(int bytes) {
+      if (static_cast<std::size_t>(bytes) > arena_.size())
+        arena_.resize(bytes);
+    }
+
+    /// \return size of the packed data in bytes
+    [[nodiscard]] int size() const {
+      return size_;
+    }
+
+    /// \return size of the buffer in bytes
+    [[nodiscard]] int capacity() const {
+      return static_cast<int>(arena_.size());
+    }
+
+    /// \return number of packed bytes that have not been unpacked yet
+    [[nodiscard]] int remaining() const {
+      return size_ - position_;
+    }
+
+    /// \return pointer to the packed data
+    [[nodiscard]] const void *data() const {
+      return arena_.data();
+    }
+
+    friend class impl::base_communicator;
+  };
+
+}  // namespace mpl
+
+#endif
@@ -3,6 +3,9 @@
 #define MPL_REQUEST_HPP
 
 #include <mpi.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <optional>
 #include <vector>
@@ -16,6 +19,8 @@ namespace mpl {
 
   class irequest_pool;
 
+  class prequest_pool;
+
   class rrequest_pool;
 
   /// Indicates kind of outcome of test for request completion.
@@ -45,20 +50,206 @@ namespace mpl {
       friend class request_pool<base_irequest>;
     };
 
+    /// Base class of persistent operations, which are not provided by the MPI implementation
+    /// as a persistent request but are emulated by MPL.
+    class persistent_operation {
+    public:
+      persistent_operation() = default;
+
+      persistent_operation(const persistent_operation &) = delete;
+
+      void operator=(const persistent_operation &) = delete;
+
+      virtual ~persistent_operation() = default;
+
+      /// Starts the persistent operation.
+      /// \param request the request representing the operation, emulated operations replace
+      /// it by a request representing the started non-blocking operation
+      virtual void start(MPI_Request &request) = 0;
+    };
+
+    /// Persistent operation that is emulated by starting a new non-blocking operation each
+    /// time the operation is started.
+    /// \tparam F type of a function object that starts the non-blocking operation and returns
+    /// its request, owns all arguments of the operation
+    template<typename F>
+    class emulated_persistent_operation final : public persistent_operation {
+      F start_;
+
+    public:
+      explicit emulated_persistent_operation(F start) : start_{std::move(start)} {
+      }
+
+      void start(MPI_Request &request) override {
+        request = start_();
+      }
+    };
+
     class base_prequest {
       MPI_Request request_{MPI_REQUEST_NULL};
+      std::shared_ptr<persistent_operation> operation_;
 
     public:
       explicit base_prequest(MPI_Request request) : request_{request} {
       }
 
+      base_prequest(MPI_Request request, std::shared_ptr<persistent_operation> operation)
+          : request_{request}, operation_{std::move(operation)} {
+      }
+
       friend class base_request<base_prequest>;
 
       friend class request_pool<base_prequest>;
+
+      friend class mpl::prequest;
+    };
+
+    //------------------------------------------------------------------
+
+    class progress_engine;
+
+    /// Base class of all operations, which are implemented by MPL as a state machine and
+    /// which are driven by the progress engine.  Each task is represented to the user by an
+    /// MPI generalized request, which is completed by the task when the operation finished.
+    class progress_task {
+      struct request_state {
+        MPI_Status status{};
+        std::atomic<bool> cancel_requested{false};
+      };
+
+      MPI_Request request_{MPI_REQUEST_NULL};
+      request_state *state_{nullptr};
+
+      static int query(void *state, MPI_Status *s) {
+        auto *request_state{static_cast<progress_task::request_state *>(state)};
+        const int error_backup{s->MPI_ERROR};
+        *s = request_state->status;
+        s->MPI_ERROR = error_backup;
+        return MPI_SUCCESS;
+      }
+
+      static int free(void *state) {
+        delete static_cast<progress_task::request_state *>(state);
+        return MPI_SUCCESS;
+      }
+
+      static int cancel(void *state, int complete) {
+        if (complete == 0)
+          static_cast<progress_task::request_state *>(state)->cancel_requested = true;
+        return MPI_SUCCESS;
+      }
+
+      MPI_Request start() {
+        state_ = new request_state();
+        MPI_Grequest_start(query, free, cancel, state_, &request_);
+        return request_;
+      }
+
+    protected:
+      progress_task() = default;
+
+      /// \return true if the user has requested to cancel the operation
+      [[nodiscard]] bool cancel_requested() const {
+        return state_->cancel_requested;
+      }
+
+      /// Completes the generalized request that represents the task.  The task must not
+      /// perform any further MPI operation after calling this method.
+      /// \param s status of the completed operation as reported to the user
+      void complete(const MPI_Status &s) {
+        state_->status = s;
+        MPI_Grequest_complete(request_);
+      }
+
+      /// Completes the generalized request that represents the task and marks it as
+      /// cancelled.
+      void complete_cancelled() {
+        MPI_Status s{};
+        s.MPI_SOURCE = MPI_ANY_SOURCE;
+        s.MPI_TAG = MPI_ANY_TAG;
+        MPI_Status_set_elements(&s, MPI_BYTE, 0);
+        MPI_Status_set_cancelled(&s, 1);
+        complete(s);
+      }
+
+    public:
+      progress_task(const progress_task &) = delete;
+
+      void operator=(const progress_task &) = delete;
+
+      virtual ~progress_task() = default;
+
+      /// Advances the state machine of the operation without blocking.
+      /// \return true if the operation has been completed, i.e., \c complete has been called
+      virtual bool progress() = 0;
+
+      friend class progress_engine;
     };
 
     //------------------------------------------------------------------
 
+    /// Process-wide engine that drives all operations implemented as a \c progress_task.
+    /// Progress is made whenever a request is tested or waited for, no helper threads are
+    /// involved.
+    class progress_engine {
+      std::mutex mutex_;
+      std::vector<std::unique_ptr<progress_task>> tasks_;
+      std::atomic<std::size_t> pending_{0};
+
+    public:
+      progress_engine() = default;
+
+      progress_engine(const progress_engine &) = delete;
+
+      void operator=(const progress_engine &) = delete;
+
+      /// Starts a new task and hands it over to the engine.
+      /// \param task the task to start
+      /// \return generalized request representing the task
+      MPI_Request start(std::unique_ptr<progress_task> task) {
+        const MPI_Request request{task->start()};
+        std::lock_guard lock{mutex_};
+        // tasks are progressed in the order of their creation to retain MPI's non-overtaking
+        // message ordering, thus, a new task may be progressed eagerly only if there is no
+        // other pending task
+        if (not(tasks_.empty() and task->progress())) {
+          tasks_.push_back(std::move(task));
+          ++pending_;
+        }
+        return request;
+      }
+
+      /// \return true if there are no pending tasks
+      [[nodiscard]] bool idle() const {
+        return pending_ == 0;
+      }
+
+      /// Advances all pending tasks.  Returns immediately if another thread is already
+      /// making progress.
+      void progress() {
+        if (idle())
+          return;
+        std::unique_lock lock{mutex_, std::try_to_lock};
+        if (not lock.owns_lock())
+          return;
+        auto i{tasks_.begin()};
+        while (i != tasks_.end()) {
+          if ((*i)->progress()) {
+            i = tasks_.erase(i);
+            --pending_;
+          } else
+            ++i;
+        }
+      }
+    };
+
+    inline progress_engine &get_progress_engine() {
+      static progress_engine engine;
+      return engine;
+    }
+
+    //------------------------------------------------------------------
+
     template<typename T>
     class base_request {
     protected:
@@ -106,6 +297,7 @@ namespace mpl {
       std::optional<status_t> test() {
         int result{true};
         status_t s;
+        get_progress_engine().progress();
         MPI_Test(&request_, &result, static_cast<MPI_Status *>(&s));
         if (result != 0)
           return s;
@@ -116,6 +308,14 @@ namespace mpl {
       /// \return operation's status after completion
       status_t wait() {
         status_t s;
+        auto &engine{get_progress_engine()};
+        while (not engine.idle()) {
+          engine.progress();
+          int result{true};
+          MPI_Test(&request_, &result, static_cast<MPI_Status *>(&s));
+          if (result != 0)
+            return s;
+        }
         MPI_Wait(&request_, static_cast<MPI_Status *>(&s));
         return s;
       }
@@ -125,6 +325,7 @@ namespace mpl {
       std::optional<status_t> get_status() {
         int result{true};
         status_t s;
+        get_progress_engine().progress();
         MPI_Request_get_status(request_, &result, static_cast<MPI_Status *>(&s));
         if (result != 0)
           return s;
@@ -214,6 +415,12 @@ namespace mpl {
       /// \return pair containing the outcome of the wait operation and an index to the
       /// completed request if there was any pending request
       std::pair<test_result, size_type> waitany() {
+        auto &engine{get_progress_engine()};
+        while (not engine.idle()) {
+          const auto result{testany()};
+          if (result.first != test_result::no_completed)
+            return result;
+        }
         int index;
         status_t s;
         MPI_Waitany(size(), &requests_[0], &index, static_cast<MPI_Status *>(&s));
@@ -230,6 +437,7 @@ namespace mpl {
       std::pair<test_result, size_type> testany() {
         int index, flag;
         status_t s;
+        get_progress_engine().progress();
         MPI_Testany(size(), &requests_[0], &index, &flag, static_cast<MPI_Status *>(&s));
         if (flag != 0 and index != MPI_UNDEFINED) {
           statuses_[index] = s;
@@ -242,6 +450,10 @@ namespace mpl {
 
       /// Waits for completion of all pending requests.
       void waitall() {
+        auto &engine{get_progress_engine()};
+        while (not engine.idle())
+          if (testall())
+            return;
         MPI_Waitall(size(), &requests_[0], static_cast<MPI_Status *>(&statuses_[0]));
       }
 
@@ -249,6 +461,7 @@ namespace mpl {
       /// \return true if all pending requests have completed
       bool testall() {
         int flag;
+        get_progress_engine().progress();
         MPI_Testall(size(), &requests_[0], &flag, static_cast<MPI_Status *>(&statuses_[0]));
         return static_cast<bool>(flag);
       }
@@ -257,6 +470,12 @@ namespace mpl {
       /// \return pair containing the outcome of the wait operation and a list of indices to
       /// the completed requests if there was any pending request
       std::pair<test_result, std::vector<size_type>> waitsome() {
+        auto &engine{get_progress_engine()};
+        while (not engine.idle()) {
+          auto result{testsome()};
+          if (result.first != test_result::no_completed)
+            return result;
+        }
         std::vector<int> out_indices(size());
         std::vector<status_t> out_statuses(size());
         int count;
@@ -279,6 +498,7 @@ namespace mpl {
         std::vector<int> out_indices(size());
         std::vector<status_t> out_statuses(size());
         int count;
+        get_progress_engine().progress();
         MPI_Testsome(size(), &requests_[0], &count, out_indices.data(),
                      static_cast<MPI_Status *>(&out_statuses[0]));
         if (count != MPI_UNDEFINED) {
@@ -366,9 +586,11 @@ namespace mpl {
     using base = impl::base_request<impl::base_prequest>;
     using base::request_;
 
+    std::shared_ptr<impl::persistent_operation> operation_;
+
   public:
 #if (!defined MPL_DOXYGEN_SHOULD_SKIP_THIS)
-    prequest(const impl::base_prequest &r) : base{r} {
+    prequest(const impl::base_prequest &r) : base{r}, operation_{r.operation_} {
     }
 #endif
 
@@ -377,7 +599,8 @@ namespace mpl {
 
     /// Move constructor.
     /// \param other the request to move from
-    prequest(prequest &&other) noexcept : base{std::move(other)} {
+    prequest(prequest &&other) noexcept
+        : base{std::move(other)}, operation_{std::move(other.operation_)} {
     }
 
     /// Deleted copy operator.
@@ -388,15 +611,21 @@ namespace mpl {
     /// \return reference to the moved-to request
     prequest &operator=(prequest &&other) noexcept {
       base::operator=(std::move(other));
+      operation_ = std::move(other.operation_);
       return *this;
     }
 
     /// Start communication operation.
     void start() {
-      MPI_Start(&request_);
+      if (operation_)
+        operation_->start(request_);
+      else
+        MPI_Start(&request_);
     }
 
     friend class impl::request_pool<prequest>;
+
+    friend class prequest_pool;
   };
 
   //--------------------------------------------------------------------
@@ -406,6 +635,10 @@ namespace mpl {
     using base = impl::request_pool<prequest>;
     using base::requests_;
 
+    // operations of requests that are emulated, null pointers for all other requests
+    std::vector<std::shared_ptr<impl::persistent_operation>> operations_;
+    size_type n_operations_{0};
+
   public:
     /// Constructs an empty pool of persistent communication requests.
     prequest_pool() = default;
@@ -415,7 +648,10 @@ namespace mpl {
 
     /// Move constructor.
     /// \param other the request pool to move from
-    prequest_pool(prequest_pool &&other) noexcept : base{std::move(other)} {
+    prequest_pool(prequest_pool &&other) noexcept
+        : base{std::move(other)},
+          operations_{std::move(other.operations_)},
+          n_operations_{other.n_operations_} {
     }
 
     /// Deleted copy constructor.
@@ -425,12 +661,31 @@ namespace mpl {
     /// \param other the request pool to move from
     prequest_pool &operator=(prequest_pool &&other) noexcept {
       base::operator=(std::move(other));
+      operations_ = std::move(other.operations_);
+      n_operations_ = other.n_operations_;
       return *this;
     }
 
+    /// Move a request into the request pool.
+    /// \param request request to move into the pool
+    void push(prequest &&request) {
+      if (request.operation_)
+        ++n_operations_;
+      operations_.push_back(std::move(request.operation_));
+      base::push(std::move(request));
+    }
+
     /// Start all persistent requests in the pool.
     void startall() {
-      MPI_Startall(size(), &requests_[0]);
+      if (n_operations_ == 0) {
+        MPI_Startall(size(), &requests_[0]);
+        return;
+      }
+      for (size_type i{0}; i < size(); ++i)
+        if (operations_[i])
+          operations_[i]->start(requests_[i]);
+        else
+          MPI_Start(&requests_[i]);
     }
   };
 
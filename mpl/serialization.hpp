@@ -0,0 +1,434 @@
+#if !(defined MPL_SERIALIZATION_HPP)
+
+#define MPL_SERIALIZATION_HPP
+
+#include <mpi.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <mpl/utility.hpp>
+#include <mpl/datatype.hpp>
+#include <mpl/error.hpp>
+
+
+namespace mpl {
+
+  class output_archive;
+
+  class input_archive;
+
+  /// Customization point for the serialization of user-defined types that can not be
+  /// described by an MPI data type, e.g., classes with members that are allocated on the
+  /// heap.
+  /// \tparam T the type to serialize
+  /// \details Specializations must provide the two static member functions
+  /// \code
+  /// static void serialize(mpl::output_archive &ar, const T &x);
+  /// static void deserialize(mpl::input_archive &ar, T &x);
+  /// \endcode
+  /// which write the members of \c x to the archive via <tt>ar << x.member</tt> and read them
+  /// back in the same order via <tt>ar >> x.member</tt>, respectively.  Objects of types
+  /// with a specialization of this class template are transferred in serialized form by
+  /// <tt>communicator::send</tt>, <tt>communicator::isend</tt>, <tt>communicator::recv</tt>,
+  /// <tt>communicator::irecv</tt>, <tt>communicator::bcast</tt>, and
+  /// <tt>communicator::gatherv</tt>.
+  /// \note Serialization copies the object representation of values with an MPI data type
+  /// byte by byte.  Thus, serialized messages must be exchanged between processes with equal
+  /// data representations only.
+  /// \see \c output_archive, \c input_archive
+  template<typename T>
+  struct serialization {};
+
+  namespace detail {
+
+    template<typename T, typename = void>
+    struct has_serialization : std::false_type {};
+
+    template<typename T>
+    struct has_serialization<T, std::void_t<decltype(serialization<T>::serialize(
+                                    get_object<output_archive &>(), get_object<const T &>()))>>
+        : std::true_type {};
+
+    // types that are transferred by MPL via an MPI data type, components of pairs, tuples
+    // and arrays must have MPI data types too
+    template<typename T>
+    struct has_mpi_datatype
+        : std::is_same<typename datatype_traits<T>::data_type_category,
+                       basic_or_fixed_size_type> {};
+
+    template<typename T1, typename T2>
+    struct has_mpi_datatype<std::pair<T1, T2>>
+        : std::bool_constant<has_mpi_datatype<std::remove_const_t<T1>>::value and
+                             has_mpi_datatype<T2>::value> {};
+
+    template<typename... Ts>
+    struct has_mpi_datatype<std::tuple<Ts...>>
+        : std::bool_constant<(has_mpi_datatype<Ts>::value and ...)> {};
+
+    template<typename T, std::size_t N>
+    struct has_mpi_datatype<std::array<T, N>> : has_mpi_datatype<T> {};
+
+    template<typename T>
+    inline constexpr bool has_mpi_datatype_v{has_mpi_datatype<T>::value};
+
+    // values that are serialized by copying their object representation
+    template<typename T>
+    inline constexpr bool is_bitwise_serializable_v{std::is_trivially_copyable_v<T> and
+                                                    has_mpi_datatype_v<T>};
+
+    template<typename T>
+    struct is_pair : std::false_type {};
+
+    template<typename T1, typename T2>
+    struct is_pair<std::pair<T1, T2>> : std::true_type {};
+
+    template<typename T>
+    struct is_tuple : std::false_type {};
+
+    template<typename... Ts>
+    struct is_tuple<std::tuple<Ts...>> : std::true_type {};
+
+    template<typename T>
+    struct is_std_array : std::false_type {};
+
+    template<typename T, std::size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    template<typename T>
+    struct is_optional : std::false_type {};
+
+    template<typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    // STL containers, which are serialized as their number of elements followed by their
+    // elements
+    template<typename T, typename = void>
+    struct is_serializable_container : std::false_type {};
+
+    template<typename T>
+    struct is_serializable_container<
+        T, std::void_t<typename T::value_type, decltype(get_object<const T &>().size()),
+                       decltype(get_object<const T &>().begin()),
+                       decltype(get_object<T &>().clear())>> : std::true_type {};
+
+    template<typename T, typename = void>
+    struct has_push_back : std::false_type {};
+
+    template<typename T>
+    struct has_push_back<T, std::void_t<decltype(get_object<T &>().push_back(
+                                get_object<typename T::value_type &&>()))>> : std::true_type {};
+
+    template<typename T, typename = void>
+    struct has_reserve : std::false_type {};
+
+    template<typename T>
+    struct has_reserve<T, std::void_t<decltype(get_object<T &>().reserve(1))>>
+        : std::true_type {};
+
+    // contiguous containers of bitwise serializable elements are serialized as a single block
+    template<typename T, typename = void>
+    struct is_bitwise_serializable_block : std::false_type {};
+
+    template<typename T>
+    struct is_bitwise_serializable_block<T, std::void_t<decltype(get_object<T &>().data())>>
+        : std::bool_constant<has_resize_v<T> and
+                             is_bitwise_serializable_v<typename T::value_type> and
+                             std::is_pointer_v<decltype(get_object<T &>().data())>> {};
+
+    template<typename T>
+    constexpr bool is_serializable();
+
+    template<typename T, std::size_t... I>
+    constexpr bool is_serializable_tuple(std::index_sequence<I...>) {
+      return (is_serializable<std::tuple_element_t<I, T>>() and ...);
+    }
+
+    template<typename T>
+    constexpr bool is_serializable() {
+      if constexpr (has_serialization<T>::value or is_bitwise_serializable_v<T>)
+        return true;
+      else if constexpr (is_pair<T>::value)
+        return is_serializable<std::remove_const_t<typename T::first_type>>() and
+               is_serializable<typename T::second_type>();
+      else if constexpr (is_tuple<T>::value)
+        return is_serializable_tuple<T>(std::make_index_sequence<std::tuple_size_v<T>>());
+      else if constexpr (is_std_array<T>::value or is_optional<T>::value)
+        return is_serializable<typename T::value_type>();
+      else if constexpr (is_serializable_container<T>::value)
+        return is_serializable<remove_const_from_members_t<typename T::value_type>>();
+      else
+        return false;
+    }
+
+    template<typename T>
+    inline constexpr bool is_serializable_v{is_serializable<T>()};
+
+    // types that MPL can not transfer by means of MPI data types but by serialization only,
+    // and types with a user-provided serialization
+    template<typename T, typename = void>
+    struct requires_serialization
+        : std::bool_constant<has_serialization<T>::value or
+                             (not has_mpi_datatype_v<T> and is_serializable_v<T>)> {};
+
+    template<typename T>
+    struct requires_serialization<
+        T, std::enable_if_t<std::is_base_of_v<stl_container,
+                                              typename datatype_traits<T>::data_type_category>>>
+        : std::bool_constant<
+              has_serialization<T>::value or
+              (not has_mpi_datatype_v<remove_const_from_members_t<typename T::value_type>> and
+               is_serializable_v<T>)> {};
+
+    template<typename T>
+    inline constexpr bool requires_serialization_v{requires_serialization<T>::value};
+
+    // category of data that is transferred in serialized form
+    struct serialized_type {};
+
+    template<typename T>
+    using transfer_category_t =
+        std::conditional_t<requires_serialization_v<T>, serialized_type,
+                           typename datatype_traits<T>::data_type_category>;
+
+    template<typename T>
+    void save(output_archive &ar, const T &x);
+
+    template<typename T>
+    void load(input_archive &ar, T &x);
+
+    // Byte buffer for serialized data.  Buffers are taken from and returned to a
+    // thread-local pool, such that repeated transfers of serialized data do not allocate
+    // memory.
+    class pooled_buffer {
+      static constexpr std::size_t max_pool_size{4};
+      std::vector<std::byte> buffer_;
+
+      static std::vector<std::vector<std::byte>> &pool() {
+        thread_local std::vector<std::vector<std::byte>> buffers;
+        return buffers;
+      }
+
+    public:
+      pooled_buffer() {
+        auto &buffers{pool()};
+        if (not buffers.empty()) {
+          buffer_.swap(buffers.back());
+          buffers.pop_back();
+        }
+      }
+
+      pooled_buffer(const pooled_buffer &) = delete;
+
+      void operator=(const pooled_buffer &) = delete;
+
+      ~pooled_buffer() {
+        auto &buffers{pool()};
+        if (buffers.size() < max_pool_size)
+          buffers.push_back(std::move(buffer_));
+      }
+
+      [[nodiscard]] std::vector<std::byte> &get() {
+        return buffer_;
+      }
+    };
+
+  }  // namespace detail
+
+  //--------------------------------------------------------------------
+
+  /// Archive that serializes objects into a contiguous byte buffer.
+  /// \see \c serialization
+  class output_archive {
+    std::vector<std::byte> &buffer_;
+    std::size_t size_{0};
+
+  public:
+    /// \param buffer byte buffer that the serialized data is written to, the buffer is
+    /// enlarged as required, the size of the buffer may exceed the size of the serialized
+    /// data
+    explicit output_archive(std::vector<std::byte> &buffer) : buffer_{buffer} {
+    }
+
+    output_archive(const output_archive &) = delete;
+
+    void operator=(const output_archive &) = delete;
+
+    /// Appends raw bytes to the archive.
+    /// \param data pointer to the data to write
+    /// \param bytes number of bytes to write
+    void write(const void *data, std::size_t bytes) {
+      if (bytes == 0)
+        return;
+      if (size_ + bytes > buffer_.size())
+        buffer_.resize(std::max(size_ + bytes, 2 * buffer_.size()));
+      std::memcpy(buffer_.data() + size_, data, bytes);
+      size_ += bytes;
+    }
+
+    /// Serializes an object into the archive.
+    /// \tparam T type of the object, must have an MPI data type, be a standard container,
+    /// pair, tuple, array, or optional of serializable types, or have a specialization of
+    /// \c serialization
+    /// \param x the object to serialize
+    /// \return reference to this archive (allows chaining)
+    template<typename T>
+    output_archive &operator<<(const T &x) {
+      detail::save(*this, x);
+      return *this;
+    }
+
+    /// \return pointer to the serialized data
+    [[nodiscard]] const std::byte *data() const {
+      return buffer_.data();
+    }
+
+    /// \return size of the serialized data in bytes
+    [[nodiscard]] std::size_t size() const {
+      return size_;
+    }
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Archive that deserializes objects from a contiguous byte buffer.
+  /// \see \c serialization
+  class input_archive {
+    const std::byte *first_;
+    const std::byte *last_;
+
+  public:
+    /// \param data pointer to the serialized data
+    /// \param bytes size of the serialized data in bytes
+    input_archive(const std::byte *data, std::size_t bytes)
+        : first_{data}, last_{data + bytes} {
+    }
+
+    input_archive(const input_archive &) = delete;
+
+    void operator=(const input_archive &) = delete;
+
+    /// Reads raw bytes from the archive.
+    /// \param data pointer to the memory that the data is written to
+    /// \param bytes number of bytes to read
+    void read(void *data, std::size_t bytes) {
+      if (bytes == 0)
+        return;
+#if defined MPL_DEBUG
+      if (static_cast<std::size_t>(last_ - first_) < bytes)
+        throw invalid_size();
+#endif
+      std::memcpy(data, first_, bytes);
+      first_ += bytes;
+    }
+
+    /// Deserializes an object from the archive.
+    /// \tparam T type of the object, must have an MPI data type, be a standard container,
+    /// pair, tuple, array, or optional of serializable types, or have a specialization of
+    /// \c serialization
+    /// \param x the object to deserialize, previous content is replaced
+    /// \return reference to this archive (allows chaining)
+    template<typename T>
+    input_archive &operator>>(T &x) {
+      detail::load(*this, x);
+      return *this;
+    }
+
+    /// \return number of bytes that have not been read yet
+    [[nodiscard]] std::size_t remaining() const {
+      return static_cast<std::size_t>(last_ - first_);
+    }
+  };
+
+  //--------------------------------------------------------------------
+
+  namespace detail {
+
+    template<typename T>
+    void save(output_archive &ar, const T &x) {
+      static_assert(is_serializable_v<T>, "type is not serializable");
+      if constexpr (has_serialization<T>::value)
+        serialization<T>::serialize(ar, x);
+      else if constexpr (is_bitwise_serializable_v<T>)
+        ar.write(&x, sizeof(T));
+      else if constexpr (is_pair<T>::value) {
+        save(ar, x.first);
+        save(ar, x.second);
+      } else if constexpr (is_tuple<T>::value)
+        std::apply([&ar](const auto &...xs) { (save(ar, xs), ...); }, x);
+      else if constexpr (is_std_array<T>::value) {
+        for (const auto &element : x)
+          save(ar, element);
+      } else if constexpr (is_optional<T>::value) {
+        save(ar, x.has_value());
+        if (x.has_value())
+          save(ar, *x);
+      } else {
+        using value_type = remove_const_from_members_t<typename T::value_type>;
+        const std::uint64_t n{x.size()};
+        save(ar, n);
+        if constexpr (is_bitwise_serializable_block<T>::value)
+          ar.write(x.data(), n * sizeof(value_type));
+        else
+          for (const auto &element : x)
+            save<value_type>(ar, element);
+      }
+    }
+
+    template<typename T>
+    void load(input_archive &ar, T &x) {
+      static_assert(is_serializable_v<T>, "type is not serializable");
+      if constexpr (has_serialization<T>::value)
+        serialization<T>::deserialize(ar, x);
+      else if constexpr (is_bitwise_serializable_v<T>)
+        ar.read(&x, sizeof(T));
+      else if constexpr (is_pair<T>::value) {
+        load(ar, const_cast<std::remove_const_t<typename T::first_type> &>(x.first));
+        load(ar, x.second);
+      } else if constexpr (is_tuple<T>::value)
+        std::apply([&ar](auto &...xs) { (load(ar, xs), ...); }, x);
+      else if constexpr (is_std_array<T>::value) {
+        for (auto &element : x)
+          load(ar, element);
+      } else if constexpr (is_optional<T>::value) {
+        bool has_value;
+        load(ar, has_value);
+        if (has_value) {
+          x.emplace();
+          load(ar, *x);
+        } else
+          x.reset();
+      } else {
+        using value_type = remove_const_from_members_t<typename T::value_type>;
+        std::uint64_t n;
+        load(ar, n);
+        x.clear();
+        if constexpr (is_bitwise_serializable_block<T>::value) {
+          x.resize(n);
+          ar.read(x.data(), n * sizeof(value_type));
+        } else {
+          if constexpr (has_reserve<T>::value)
+            x.reserve(n);
+          for (std::uint64_t i{0}; i < n; ++i) {
+            value_type element;
+            load(ar, element);
+            if constexpr (has_push_back<T>::value)
+              x.push_back(std::move(element));
+            else
+              x.emplace_hint(x.end(), std::move(element));
+          }
+        }
+      }
+    }
+
+  }  // namespace detail
+
+}  // namespace mpl
+
+#endif
@@ -3,6 +3,7 @@
 #define MPL_TOPOLOGY_COMMUNICATOR_HPP
 
 #include <mpi.h>
+#include <memory>
 #include <vector>
 
 
@@ -11,6 +12,69 @@ namespace mpl::impl {
   /// Base class for communicators with a topology.
   class topology_communicator : public mpl::communicator {
   protected:
+    // non-blocking neighbor all-to-all with individual data types per neighbor, the task owns
+    // the count, displacement and data type arrays until the operation has completed
+    class ineighbor_alltoallw_task final : public progress_task {
+      std::vector<int> counts_;
+      displacements senddispls_;
+      std::vector<MPI_Datatype> sendtypes_;
+      displacements recvdispls_;
+      std::vector<MPI_Datatype> recvtypes_;
+      MPI_Request req_{MPI_REQUEST_NULL};
+
+    public:
+      template<typename T>
+      ineighbor_alltoallw_task(const T *senddata, const layouts<T> &sendls,
+                               const displacements &senddispls, T *recvdata,
+                               const layouts<T> &recvls, const displacements &recvdispls,
+                               MPI_Comm comm)
+          : counts_(recvls.size(), 1),
+            senddispls_{senddispls},
+            sendtypes_{sendls.datatypes()},
+            recvdispls_{recvdispls},
+            recvtypes_{recvls.datatypes()} {
+        MPI_Ineighbor_alltoallw(senddata, counts_.data(), senddispls_(), sendtypes_.data(),
+                                recvdata, counts_.data(), recvdispls_(), recvtypes_.data(),
+                                comm, &req_);
+      }
+
+      bool progress() override {
+        int flag;
+        MPI_Status s;
+        MPI_Test(&req_, &flag, &s);
+        if (flag == 0)
+          return false;
+        complete(s);
+        return true;
+      }
+    };
+
+    // arguments of a neighbor all-to-all operation with individual data types, the layouts
+    // keep the data types alive as long as a persistent request refers to them
+    template<typename T>
+    struct neighbor_alltoallw_arguments {
+      layouts<T> sendls;
+      layouts<T> recvls;
+      std::vector<int> sendcounts;
+      displacements senddispls;
+      std::vector<MPI_Datatype> sendtypes;
+      std::vector<int> recvcounts;
+      displacements recvdispls;
+      std::vector<MPI_Datatype> recvtypes;
+
+      neighbor_alltoallw_arguments(const layouts<T> &sendls_, const displacements &senddispls_,
+                                   const layouts<T> &recvls_, const displacements &recvdispls_)
+          : sendls{sendls_},
+            recvls{recvls_},
+            sendcounts(sendls_.size(), 1),
+            senddispls{senddispls_},
+            sendtypes{sendls_.datatypes()},
+            recvcounts(recvls_.size(), 1),
+            recvdispls{recvdispls_},
+            recvtypes{recvls_.datatypes()} {
+      }
+    };
+
     /// Default constructor.
     /// \note Objects of this class should not be instantiated by MPL users, just a base
     /// class.
@@ -104,6 +168,27 @@ namespace mpl::impl {
       return impl::base_irequest{req};
     }
 
+    // --- persistent neighbor allgather ---
+    /// Creates a persistent request for gathering messages from all neighbouring processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param senddata data to send to all neighbours
+    /// \param recvdata pointer to continuous storage for incoming messages
+    /// \return persistent request, the operation is carried out each time the request is
+    /// started
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.  The request must be started by all
+    /// processes in the same order as other collective operations.
+    template<typename T>
+    mpl::prequest neighbor_allgather_init(const T &senddata, T *recvdata) const {
+      const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+      return emulated_prequest([senddata = &senddata, recvdata, datatype, comm = comm_]() {
+        MPI_Request req;
+        MPI_Ineighbor_allgather(senddata, 1, datatype, recvdata, 1, datatype, comm, &req);
+        return req;
+      });
+    }
+
     // === get varying amount of data from each neighbor and stores in non-contiguous memory
     // --- blocking neighbor allgather ---
     /// Gather messages with a variable amount of data from all neighbouring processes.
@@ -280,6 +365,29 @@ namespace mpl::impl {
       return impl::base_irequest{req};
     }
 
+    // --- persistent neighbor all-to-all ---
+    /// Creates a persistent request for sending messages to all neighbouring processes and
+    /// receiving messages from all neighbouring processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param senddata pointer to continuous storage for outgoing messages
+    /// \param recvdata pointer to continuous storage for incoming messages
+    /// \return persistent request, the operation is carried out each time the request is
+    /// started
+    /// \details See \ref neighbor_alltoall for the meaning of the arguments.
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.  The request must be started by all
+    /// processes in the same order as other collective operations.
+    template<typename T>
+    mpl::prequest neighbor_alltoall_init(const T *senddata, T *recvdata) const {
+      const MPI_Datatype datatype{detail::datatype_traits<T>::get_datatype()};
+      return emulated_prequest([senddata, recvdata, datatype, comm = comm_]() {
+        MPI_Request req;
+        MPI_Ineighbor_alltoall(senddata, 1, datatype, recvdata, 1, datatype, comm, &req);
+        return req;
+      });
+    }
+
     // === each rank sends a varying number of values to each neighbor with possibly different
     // layouts
     // --- blocking neighbor all-to-all ---
@@ -310,13 +418,10 @@ namespace mpl::impl {
                             const displacements &senddispls, T *recvdata,
                             const layouts<T> &recvls, const displacements &recvdispls) const {
       const std::vector<int> counts(recvls.size(), 1);
-      static_assert(
-          sizeof(decltype(*sendls())) == sizeof(MPI_Datatype),
-          "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-      MPI_Neighbor_alltoallw(senddata, counts.data(), senddispls(),
-                             reinterpret_cast<const MPI_Datatype *>(sendls()), recvdata,
-                             counts.data(), recvdispls(),
-                             reinterpret_cast<const MPI_Datatype *>(recvls()), comm_);
+      const auto sendtypes{sendls.datatypes()};
+      const auto recvtypes{recvls.datatypes()};
+      MPI_Neighbor_alltoallw(senddata, counts.data(), senddispls(), sendtypes.data(), recvdata,
+                             counts.data(), recvdispls(), recvtypes.data(), comm_);
     }
 
     /// Sends messages with a variable amount of data to all neighbouring processes and
@@ -376,16 +481,9 @@ namespace mpl::impl {
                                       const displacements &senddispls, T *recvdata,
                                       const layouts<T> &recvls,
                                       const displacements &recvdispls) const {
-      std::vector<int> counts(recvls.size(), 1);
-      MPI_Request req;
-      static_assert(
-          sizeof(decltype(*sendls())) == sizeof(MPI_Datatype),
-          "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-      MPI_Ineighbor_alltoallw(senddata, counts.data(), senddispls(),
-                              reinterpret_cast<const MPI_Datatype *>(sendls()), recvdata,
-                              counts.data(), recvdispls(),
-                              reinterpret_cast<const MPI_Datatype *>(recvls()), comm_, &req);
-      return impl::base_irequest{req};
+      return impl::base_irequest{get_progress_engine().start(
+          std::make_unique<ineighbor_alltoallw_task>(senddata, sendls, senddispls, recvdata,
+                                                     recvls, recvdispls, comm_))};
     }
 
     /// Sends messages with a variable amount of data to all neighbouring processes and
@@ -417,6 +515,63 @@ namespace mpl::impl {
       return ineighbor_alltoallv(senddata, sendls, sendrecvdispls, recvdata, recvls,
                                  sendrecvdispls);
     }
+
+    // --- persistent neighbor all-to-all ---
+    /// Creates a persistent request for sending messages with a variable amount of data to
+    /// all neighbouring processes and receiving messages with a variable amount of data from
+    /// all neighbouring processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param senddata pointer to continuous storage for outgoing messages
+    /// \param sendls memory layouts of the data to send
+    /// \param senddispls displacements of the data to send
+    /// \param recvdata pointer to continuous storage for incoming messages
+    /// \param recvls memory layouts of the data to receive
+    /// \param recvdispls displacements of the data to receive
+    /// \return persistent request, the operation is carried out each time the request is
+    /// started
+    /// \details See \ref neighbor_alltoallv for the meaning of the arguments.  Layouts and
+    /// displacements are stored by the request and may be destroyed after the function has
+    /// returned.
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.  The request must be started by all
+    /// processes in the same order as other collective operations.
+    template<typename T>
+    mpl::prequest neighbor_alltoallv_init(const T *senddata, const layouts<T> &sendls,
+                                          const displacements &senddispls, T *recvdata,
+                                          const layouts<T> &recvls,
+                                          const displacements &recvdispls) const {
+      neighbor_alltoallw_arguments<T> args(sendls, senddispls, recvls, recvdispls);
+      return emulated_prequest([senddata, recvdata, a = std::move(args), comm = comm_]() {
+        MPI_Request req;
+        MPI_Ineighbor_alltoallw(senddata, a.sendcounts.data(), a.senddispls(),
+                                a.sendtypes.data(), recvdata, a.recvcounts.data(),
+                                a.recvdispls(), a.recvtypes.data(), comm, &req);
+        return req;
+      });
+    }
+
+    /// Creates a persistent request for sending messages with a variable amount of data to
+    /// all neighbouring processes and receiving messages with a variable amount of data from
+    /// all neighbouring processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param senddata pointer to continuous storage for outgoing messages
+    /// \param sendls memory layouts of the data to send
+    /// \param recvdata pointer to continuous storage for incoming messages
+    /// \param recvls memory layouts of the data to receive
+    /// \return persistent request, the operation is carried out each time the request is
+    /// started
+    /// \details See \ref neighbor_alltoallv for the meaning of the arguments.
+    /// \note This is a collective operation and must be called (possibly by utilizing another
+    /// overload) by all processes in the communicator.  The request must be started by all
+    /// processes in the same order as other collective operations.
+    template<typename T>
+    mpl::prequest neighbor_alltoallv_init(const T *senddata, const layouts<T> &sendls,
+                                          T *recvdata, const layouts<T> &recvls) const {
+      return neighbor_alltoallv_init(senddata, sendls, displacements(sendls.size()), recvdata,
+                                     recvls, displacements(recvls.size()));
+    }
   };
 
 }  // namespace mpl::impl
@@ -0,0 +1,558 @@
+#if !(defined MPL_TUNED_COMMUNICATOR_HPP)
+
+#define MPL_TUNED_COMMUNICATOR_HPP
+
+#include <mpi.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <mpl/collective_algorithms.hpp>
+#include <mpl/comm_group.hpp>
+#include <mpl/displacements.hpp>
+#include <mpl/environment.hpp>
+#include <mpl/layout.hpp>
+#include <mpl/operator.hpp>
+
+
+namespace mpl {
+
+  /// Algorithms for all-reduce operations.
+  enum class allreduce_algorithm {
+    /// algorithm that is chosen by the MPI library
+    native,
+    /// recursive doubling, latency-optimal, suited for short messages
+    recursive_doubling,
+    /// reduce-scatter and allgather along a ring of processes, bandwidth-optimal, suited for
+    /// long messages, falls back to recursive doubling for non-commutative reduction
+    /// operations
+    ring,
+    /// reduce-scatter via recursive halving and allgather via recursive doubling, suited for
+    /// medium and long messages
+    rabenseifner
+  };
+
+  /// Algorithms for broadcast operations.
+  enum class bcast_algorithm {
+    /// algorithm that is chosen by the MPI library
+    native,
+    /// broadcast along a binomial tree, suited for short messages
+    binomial,
+    /// segmented broadcast along a chain of processes, suited for long messages
+    pipelined_chain
+  };
+
+  /// Algorithms for all-to-all operations with a variable amount of data per process.
+  enum class alltoallv_algorithm {
+    /// algorithm that is chosen by the MPI library
+    native,
+    /// exchange with one process per step, suited for long messages
+    pairwise,
+    /// exchange in a logarithmic number of steps via intermediate processes (Bruck's
+    /// algorithm), suited for short messages
+    bruck
+  };
+
+  /// Choice of algorithms for collective operations depending on the message size.  Message
+  /// sizes are grouped into buckets, the k-th bucket holds messages with a size in bytes of
+  /// more than \f$2^{k-1}\f$ and at most \f$2^k\f$.  Initially, the algorithm that is chosen
+  /// by the MPI library is selected for all message sizes.
+  /// \see \c tuned_communicator
+  class algorithm_selection {
+  public:
+    /// number of message size buckets, the last bucket holds all messages that are larger
+    /// than the upper bound of the second to last bucket
+    static constexpr int num_buckets{48};
+
+  private:
+    std::array<allreduce_algorithm, num_buckets> allreduce_;
+    std::array<bcast_algorithm, num_buckets> bcast_;
+    std::array<alltoallv_algorithm, num_buckets> alltoallv_;
+
+  public:
+    /// Determines the message size bucket.
+    /// \param bytes message size in bytes
+    /// \return index of the bucket that holds messages of the given size
+    [[nodiscard]] static int bucket(std::size_t bytes) {
+      int k{0};
+      while (k + 1 < num_buckets and (std::size_t{1} << k) < bytes)
+        ++k;
+      return k;
+    }
+
+    /// Creates a selection that chooses the algorithms of the MPI library.
+    algorithm_selection() {
+      allreduce_.fill(allreduce_algorithm::native);
+      bcast_.fill(bcast_algorithm::native);
+      alltoallv_.fill(alltoallv_algorithm::native);
+    }
+
+    /// \param bytes message size in bytes
+    /// \return all-reduce algorithm for messages of the given size
+    [[nodiscard]] allreduce_algorithm allreduce(std::size_t bytes) const {
+      return allreduce_[bucket(bytes)];
+    }
+
+    /// Selects an all-reduce algorithm for the bucket that holds the given message size.
+    /// \param bytes message size in bytes
+    /// \param a all-reduce algorithm
+    void allreduce(std::size_t bytes, allreduce_algorithm a) {
+      allreduce_[bucket(bytes)] = a;
+    }
+
+    /// \param bytes message size in bytes
+    /// \return broadcast algorithm for messages of the given size
+    [[nodiscard]] bcast_algorithm bcast(std::size_t bytes) const {
+      return bcast_[bucket(bytes)];
+    }
+
+    /// Selects a broadcast algorithm for the bucket that holds the given message size.
+    /// \param bytes message size in bytes
+    /// \param a broadcast algorithm
+    void bcast(std::size_t bytes, bcast_algorithm a) {
+      bcast_[bucket(bytes)] = a;
+    }
+
+    /// \param bytes average size of the messages that are sent by a process to each process
+    /// in bytes
+    /// \return all-to-all algorithm for messages of the given size
+    [[nodiscard]] alltoallv_algorithm alltoallv(std::size_t bytes) const {
+      return alltoallv_[bucket(bytes)];
+    }
+
+    /// Selects an all-to-all algorithm for the bucket that holds the given message size.
+    /// \param bytes average size of the messages that are sent by a process to each process
+    /// in bytes
+    /// \param a all-to-all algorithm
+    void alltoallv(std::size_t bytes, alltoallv_algorithm a) {
+      alltoallv_[bucket(bytes)] = a;
+    }
+
+    friend class tuned_communicator;
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Communicator that carries out collective operations by algorithms of the MPL library or
+  /// of the MPI library, the algorithm is chosen by the message size.  Choices may be made
+  /// explicitly via an \ref algorithm_selection object or by measuring the performance of all
+  /// algorithms on the actual communicator via \ref autotune.  Choices may be saved to a file
+  /// and loaded in later runs.
+  /// \note Operations on a tuned communicator are carried out on a duplicate of the
+  /// communicator passed to the constructor.  Thus, they do not interfere with communication
+  /// on the original communicator.
+  class tuned_communicator {
+    communicator comm_;
+    algorithm_selection selection_;
+    std::size_t segment_bytes_{std::size_t{1} << 16};
+
+    static constexpr const char *allreduce_names[]{"native", "recursive_doubling", "ring",
+                                                   "rabenseifner"};
+    static constexpr const char *bcast_names[]{"native", "binomial", "pipelined_chain"};
+    static constexpr const char *alltoallv_names[]{"native", "pairwise", "bruck"};
+
+    // measures the time of an operation, the maximum time over all processes is returned,
+    // such that all processes make the same choice
+    template<typename G>
+    double time(G g, int repetitions) const {
+      g();
+      comm_.barrier();
+      const double start{environment::wtime()};
+      for (int i{0}; i < repetitions; ++i)
+        g();
+      double t{(environment::wtime() - start) / repetitions};
+      comm_.allreduce(max<double>(), t);
+      return t;
+    }
+
+    // index of the name in the list of names, -1 if not found
+    template<std::size_t N>
+    static int find_name(const char *const (&names)[N], const std::string &name) {
+      for (std::size_t i{0}; i < N; ++i)
+        if (name == names[i])
+          return static_cast<int>(i);
+      return -1;
+    }
+
+    template<typename A, std::size_t N>
+    static void write_line(std::ostream &out, const char *operation,
+                           const std::array<A, algorithm_selection::num_buckets> &algorithms,
+                           const char *const (&names)[N]) {
+      out << operation;
+      for (const A a : algorithms)
+        out << ' ' << names[static_cast<int>(a)];
+      out << '\n';
+    }
+
+    template<typename A, std::size_t N>
+    static bool read_line(std::istream &in, const char *operation,
+                          std::array<A, algorithm_selection::num_buckets> &algorithms,
+                          const char *const (&names)[N]) {
+      std::string word;
+      if (not(in >> word) or word != operation)
+        return false;
+      for (A &a : algorithms) {
+        if (not(in >> word))
+          return false;
+        const int i{find_name(names, word)};
+        if (i < 0)
+          return false;
+        a = static_cast<A>(i);
+      }
+      return true;
+    }
+
+  public:
+    /// Creates a tuned communicator that chooses the algorithms of the MPI library.
+    /// \param comm the communicator
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    explicit tuned_communicator(const communicator &comm) : comm_{comm} {
+    }
+
+    /// Creates a tuned communicator with a given choice of algorithms.
+    /// \param comm the communicator
+    /// \param selection choice of algorithms, must be equal on all processes
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    tuned_communicator(const communicator &comm, const algorithm_selection &selection)
+        : comm_{comm}, selection_{selection} {
+    }
+
+    /// Determines the total number of processes.
+    /// \return number of processes
+    [[nodiscard]] int size() const {
+      return comm_.size();
+    }
+
+    /// Determines the rank of the calling process.
+    /// \return the rank of the calling process
+    [[nodiscard]] int rank() const {
+      return comm_.rank();
+    }
+
+    /// \return current choice of algorithms
+    [[nodiscard]] const algorithm_selection &selection() const {
+      return selection_;
+    }
+
+    /// Sets the choice of algorithms.
+    /// \param selection choice of algorithms, must be equal on all processes
+    void selection(const algorithm_selection &selection) {
+      selection_ = selection;
+    }
+
+    /// \return size of the segments in bytes that are sent by the pipelined broadcast and
+    /// ring all-reduce algorithms
+    [[nodiscard]] std::size_t segment_size() const {
+      return segment_bytes_;
+    }
+
+    /// Sets the size of the segments that are sent by the pipelined broadcast and ring
+    /// all-reduce algorithms.
+    /// \param bytes segment size in bytes, must be equal on all processes
+    void segment_size(std::size_t bytes) {
+      segment_bytes_ = bytes;
+    }
+
+    // === allreduce ===
+    /// Performs an element-wise reduction operation over all processes and broadcasts the
+    /// result, the algorithm is chosen by the message size.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation
+    /// is performed on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param f reduction operation
+    /// \param send_data input data for the reduction operation
+    /// \param recv_data will hold the results of the reduction operation
+    /// \param l memory layouts of the data to send and to receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T, typename F>
+    void allreduce(F f, const T *send_data, T *recv_data, const contiguous_layout<T> &l) const {
+      allreduce(selection_.allreduce(l.size() * sizeof(T)), f, send_data, recv_data, l);
+    }
+
+    /// Performs an element-wise reduction operation over all processes and broadcasts the
+    /// result by a given algorithm.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation
+    /// is performed on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param a all-reduce algorithm, must be equal on all processes
+    /// \param f reduction operation
+    /// \param send_data input data for the reduction operation
+    /// \param recv_data will hold the results of the reduction operation
+    /// \param l memory layouts of the data to send and to receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T, typename F>
+    void allreduce(allreduce_algorithm a, F f, const T *send_data, T *recv_data,
+                   const contiguous_layout<T> &l) const {
+      const int n{static_cast<int>(l.size())};
+      switch (a) {
+        case allreduce_algorithm::native:
+          comm_.allreduce(f, send_data, recv_data, l);
+          break;
+        case allreduce_algorithm::recursive_doubling:
+          detail::allreduce_recursive_doubling(f, send_data, recv_data, n,
+                                               comm_.native_handle());
+          break;
+        case allreduce_algorithm::ring:
+          if constexpr (op_traits<F>::is_commutative)
+            detail::allreduce_ring(f, send_data, recv_data, n, comm_.native_handle(),
+                                   segment_bytes_);
+          else
+            detail::allreduce_recursive_doubling(f, send_data, recv_data, n,
+                                                 comm_.native_handle());
+          break;
+        case allreduce_algorithm::rabenseifner:
+          detail::allreduce_rabenseifner(f, send_data, recv_data, n, comm_.native_handle());
+          break;
+      }
+    }
+
+    // === broadcast ===
+    /// Broadcasts a message from a process to all other processes, the algorithm is chosen by
+    /// the message size.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the sending process
+    /// \param data buffer for sending/receiving data
+    /// \param l memory layout of the data to send/receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void bcast(int root_rank, T *data, const contiguous_layout<T> &l) const {
+      bcast(selection_.bcast(l.size() * sizeof(T)), root_rank, data, l);
+    }
+
+    /// Broadcasts a message from a process to all other processes by a given algorithm.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param a broadcast algorithm, must be equal on all processes
+    /// \param root_rank rank of the sending process
+    /// \param data buffer for sending/receiving data
+    /// \param l memory layout of the data to send/receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void bcast(bcast_algorithm a, int root_rank, T *data, const contiguous_layout<T> &l) const {
+      const int n{static_cast<int>(l.size())};
+      switch (a) {
+        case bcast_algorithm::native:
+          comm_.bcast(root_rank, data, l);
+          break;
+        case bcast_algorithm::binomial:
+          detail::bcast_binomial(root_rank, data, n, comm_.native_handle());
+          break;
+        case bcast_algorithm::pipelined_chain:
+          detail::bcast_pipelined_chain(root_rank, data, n, comm_.native_handle(),
+                                        segment_bytes_);
+          break;
+      }
+    }
+
+    // === alltoallv ===
+    /// Sends messages with a variable amount of data to all processes and receives messages
+    /// with a variable amount of data from all processes, the algorithm is chosen by the
+    /// largest average message size over all processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param send_data pointer to continuous storage for outgoing messages
+    /// \param sendls memory layouts of the data to send
+    /// \param senddispls displacements of the data to send
+    /// \param recv_data pointer to continuous storage for incoming messages
+    /// \param recvls memory layouts of the data to receive
+    /// \param recvdispls displacements of the data to receive
+    /// \note This is a collective operation and must be called by all processes.  Determining
+    /// the message size requires an additional all-reduce operation on a single value.
+    template<typename T>
+    void alltoallv(const T *send_data, const contiguous_layouts<T> &sendls,
+                   const displacements &senddispls, T *recv_data,
+                   const contiguous_layouts<T> &recvls, const displacements &recvdispls) const {
+      std::size_t bytes{0};
+      for (const auto &l : sendls)
+        bytes += l.size() * sizeof(T);
+      comm_.allreduce(max<std::size_t>(), bytes);
+      alltoallv(selection_.alltoallv(bytes / size()), send_data, sendls, senddispls, recv_data,
+                recvls, recvdispls);
+    }
+
+    /// Sends messages with a variable amount of data to all processes and receives messages
+    /// with a variable amount of data from all processes by a given algorithm.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param a all-to-all algorithm, must be equal on all processes
+    /// \param send_data pointer to continuous storage for outgoing messages
+    /// \param sendls memory layouts of the data to send
+    /// \param senddispls displacements of the data to send
+    /// \param recv_data pointer to continuous storage for incoming messages
+    /// \param recvls memory layouts of the data to receive
+    /// \param recvdispls displacements of the data to receive
+    /// \note This is a collective operation and must be called by all processes.
+    template<typename T>
+    void alltoallv(alltoallv_algorithm a, const T *send_data,
+                   const contiguous_layouts<T> &sendls, const displacements &senddispls,
+                   T *recv_data, const contiguous_layouts<T> &recvls,
+                   const displacements &recvdispls) const {
+      switch (a) {
+        case alltoallv_algorithm::native:
+          comm_.alltoallv(send_data, sendls, senddispls, recv_data, recvls, recvdispls);
+          break;
+        case alltoallv_algorithm::pairwise:
+          detail::alltoallv_pairwise(send_data, sendls.sizes(), senddispls(), recv_data,
+                                     recvls.sizes(), recvdispls(), comm_.native_handle());
+          break;
+        case alltoallv_algorithm::bruck:
+          detail::alltoallv_bruck(send_data, sendls.sizes(), senddispls(), recv_data,
+                                  recvls.sizes(), recvdispls(), comm_.native_handle());
+          break;
+      }
+    }
+
+    // === tuning ===
+    /// Measures the performance of all algorithms for all message size buckets up to a given
+    /// message size and selects the fastest algorithm for each bucket.  Larger messages use
+    /// the algorithm of the largest measured bucket.
+    /// \tparam T type of the data that is used for measurements, must meet the requirements as
+    /// described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam F type of the reduction operation that is used for measuring all-reduce
+    /// operations
+    /// \param max_bytes largest message size in bytes
+    /// \param repetitions number of repetitions for each measurement
+    /// \param f reduction operation that is used for measuring all-reduce operations
+    /// \note This is a collective operation and must be called by all processes.  All
+    /// processes will select the same algorithms.
+    template<typename T = double, typename F = plus<T>>
+    void autotune(std::size_t max_bytes = std::size_t{1} << 22, int repetitions = 4,
+                  F f = F{}) {
+      const int last_bucket{algorithm_selection::bucket(max_bytes)};
+      for (int k{0}; k <= last_bucket; ++k) {
+        const std::size_t n{std::max<std::size_t>((std::size_t{1} << k) / sizeof(T), 1)};
+        const contiguous_layout<T> l(n);
+        std::vector<T> send_data(n);
+        std::vector<T> recv_data(n);
+        double best{std::numeric_limits<double>::max()};
+        for (const auto a :
+             {allreduce_algorithm::native, allreduce_algorithm::recursive_doubling,
+              allreduce_algorithm::ring, allreduce_algorithm::rabenseifner})
+          if (const double t{time(
+                  [&]() { allreduce(a, f, send_data.data(), recv_data.data(), l); },
+                  repetitions)};
+              t < best) {
+            best = t;
+            selection_.allreduce_[k] = a;
+          }
+        best = std::numeric_limits<double>::max();
+        for (const auto a : {bcast_algorithm::native, bcast_algorithm::binomial,
+                             bcast_algorithm::pipelined_chain})
+          if (const double t{time([&]() { bcast(a, 0, recv_data.data(), l); }, repetitions)};
+              t < best) {
+            best = t;
+            selection_.bcast_[k] = a;
+          }
+      }
+      std::fill(selection_.allreduce_.begin() + last_bucket + 1, selection_.allreduce_.end(),
+                selection_.allreduce_[last_bucket]);
+      std::fill(selection_.bcast_.begin() + last_bucket + 1, selection_.bcast_.end(),
+                selection_.bcast_[last_bucket]);
+      // the total amount of data of an all-to-all operation does not exceed max_bytes per
+      // process
+      const int last_alltoallv_bucket{
+          algorithm_selection::bucket(std::max<std::size_t>(max_bytes / size(), 1))};
+      for (int k{0}; k <= last_alltoallv_bucket; ++k) {
+        const std::size_t n{std::max<std::size_t>((std::size_t{1} << k) / sizeof(T), 1)};
+        contiguous_layouts<T> ls;
+        displacements displs(size());
+        for (int i{0}; i < size(); ++i) {
+          ls.push_back(contiguous_layout<T>(n));
+          displs[i] = static_cast<displacements::value_type>(i * n * sizeof(T));
+        }
+        std::vector<T> send_data(size() * n);
+        std::vector<T> recv_data(size() * n);
+        double best{std::numeric_limits<double>::max()};
+        for (const auto a : {alltoallv_algorithm::native, alltoallv_algorithm::pairwise,
+                             alltoallv_algorithm::bruck})
+          if (const double t{time(
+                  [&]() {
+                    alltoallv(a, send_data.data(), ls, displs, recv_data.data(), ls, displs);
+                  },
+                  repetitions)};
+              t < best) {
+            best = t;
+            selection_.alltoallv_[k] = a;
+          }
+      }
+      std::fill(selection_.alltoallv_.begin() + last_alltoallv_bucket + 1,
+                selection_.alltoallv_.end(), selection_.alltoallv_[last_alltoallv_bucket]);
+    }
+
+    /// Saves the current choice of algorithms to a file.  The file is written by the process
+    /// with rank zero.
+    /// \param filename name of the file
+    /// \return true if the file has been written successfully
+    /// \note This is a collective operation and must be called by all processes.
+    bool save(const std::string &filename) const {
+      int success{0};
+      if (rank() == 0) {
+        std::ofstream out(filename);
+        out << "mpl_algorithm_selection " << size() << '\n';
+        write_line(out, "allreduce", selection_.allreduce_, allreduce_names);
+        write_line(out, "bcast", selection_.bcast_, bcast_names);
+        write_line(out, "alltoallv", selection_.alltoallv_, alltoallv_names);
+        out.close();
+        success = out ? 1 : 0;
+      }
+      comm_.bcast(0, success);
+      return success != 0;
+    }
+
+    /// Loads a choice of algorithms from a file that has been written by \ref save.  The file
+    /// is read by the process with rank zero.
+    /// \param filename name of the file
+    /// \return true if the file exists and holds a choice of algorithms for a communicator of
+    /// the same size, the current choice of algorithms is not changed otherwise
+    /// \note This is a collective operation and must be called by all processes.
+    bool load(const std::string &filename) {
+      algorithm_selection selection;
+      int success{0};
+      if (rank() == 0) {
+        std::ifstream in(filename);
+        std::string word;
+        int file_size{0};
+        if (in >> word >> file_size and word == "mpl_algorithm_selection" and
+            file_size == size() and
+            read_line(in, "allreduce", selection.allreduce_, allreduce_names) and
+            read_line(in, "bcast", selection.bcast_, bcast_names) and
+            read_line(in, "alltoallv", selection.alltoallv_, alltoallv_names))
+          success = 1;
+      }
+      comm_.bcast(0, success);
+      if (success == 0)
+        return false;
+      comm_.bcast(0, selection.allreduce_);
+      comm_.bcast(0, selection.bcast_);
+      comm_.bcast(0, selection.alltoallv_);
+      selection_ = selection;
+      return true;
+    }
+
+    /// Loads a choice of algorithms from a file, if this fails, the algorithms are selected
+    /// via \ref autotune and the choice is saved to the file.
+    /// \param filename name of the file
+    /// \param max_bytes largest message size in bytes for \ref autotune
+    /// \note This is a collective operation and must be called by all processes.
+    void load_or_autotune(const std::string &filename,
+                          std::size_t max_bytes = std::size_t{1} << 22) {
+      if (not load(filename)) {
+        autotune(max_bytes);
+        save(filename);
+      }
+    }
+  };
+
+}  // namespace mpl
+
+#endif
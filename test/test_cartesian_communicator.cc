@@ -2,6 +2,8 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include <mpl/mpl.hpp>
+#include <algorithm>
+#include <vector>
 #include "test_helper.hpp"
 
 
@@ -240,6 +242,49 @@ BOOST_AUTO_TEST_CASE(cartesian_communicator_dimensions) {
 }
 
 
+// persistent neighbourhood collectives, each request is started several times
+template<typename T>
+bool cartesian_communicator_neighbor_init_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  mpl::cartesian_communicator::dimensions dimensions{mpl::cartesian_communicator::periodic};
+  mpl::cartesian_communicator comm_c{comm_world,
+                                     mpl::dims_create(comm_world.size(), dimensions)};
+  T send_val{val};
+  for (int i{0}; i < comm_c.rank(); ++i)
+    ++send_val;
+  T expected_val{val};
+  std::vector<T> expected_values;
+  for (int i{0}; i < comm_c.size(); ++i) {
+    expected_values.push_back(expected_val);
+    ++expected_val;
+  }
+  std::vector<T> expected;
+  expected.push_back(expected_values[(comm_c.rank() - 1 + comm_c.size()) % comm_c.size()]);
+  expected.push_back(expected_values[(comm_c.rank() + 1) % comm_c.size()]);
+  std::vector<T> send_data(2);
+  std::vector<T> recv_data_1(2);
+  std::vector<T> recv_data_2(2);
+  std::vector<T> recv_data_3(2);
+  mpl::layouts<T> ls;
+  ls.push_back(mpl::indexed_layout<T>({{1, 0}}));
+  ls.push_back(mpl::indexed_layout<T>({{1, 1}}));
+  mpl::prequest_pool pool;
+  pool.push(comm_c.neighbor_allgather_init(send_data[0], recv_data_1.data()));
+  pool.push(comm_c.neighbor_alltoall_init(send_data.data(), recv_data_2.data()));
+  pool.push(comm_c.neighbor_alltoallv_init(send_data.data(), ls, recv_data_3.data(), ls));
+  for (int i{0}; i < 2; ++i) {
+    for (auto *recv_data : {&recv_data_1, &recv_data_2, &recv_data_3})
+      std::fill(recv_data->begin(), recv_data->end(), T{});
+    std::fill(send_data.begin(), send_data.end(), send_val);
+    pool.startall();
+    pool.waitall();
+    if (recv_data_1 != expected or recv_data_2 != expected or recv_data_3 != expected)
+      return false;
+  }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(cartesian_communicator_neighbor_alltoall) {
   BOOST_TEST(cartesian_communicator_neighbor_alltoall_test(1.0));
   BOOST_TEST(cartesian_communicator_neighbor_alltoall_test(tuple{1, 2.0}));
@@ -252,4 +297,7 @@ BOOST_AUTO_TEST_CASE(cartesian_communicator_neighbor_alltoall) {
 
   BOOST_TEST(cartesian_communicator_ineighbor_alltoall_layout_test(1.0));
   BOOST_TEST(cartesian_communicator_ineighbor_alltoall_layout_test(tuple{1, 2.0}));
+
+  BOOST_TEST(cartesian_communicator_neighbor_init_test(1.0));
+  BOOST_TEST(cartesian_communicator_neighbor_init_test(tuple{1, 2.0}));
 }
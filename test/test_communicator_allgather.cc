@@ -26,10 +26,31 @@ bool iallgather_test(const T &val) {
 }
 
 
+template<typename T>
+bool allgather_init_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  std::vector<T> v(comm_world.size());
+  T x{};
+  auto r{comm_world.allgather_init(x, v.data())};
+  for (int i{0}; i < 2; ++i) {
+    std::fill(v.begin(), v.end(), T{});
+    x = val;
+    r.start();
+    r.wait();
+    if (not std::all_of(v.begin(), v.end(), [&val](const auto &y) { return y == val; }))
+      return false;
+  }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(allgather) {
   BOOST_TEST(allgather_test(1.0));
   BOOST_TEST(allgather_test(std::array{1, 2, 3, 4}));
 
   BOOST_TEST(iallgather_test(1.0));
   BOOST_TEST(iallgather_test(std::array{1, 2, 3, 4}));
+
+  BOOST_TEST(allgather_init_test(1.0));
+  BOOST_TEST(allgather_init_test(std::array{1, 2, 3, 4}));
 }
@@ -1,6 +1,8 @@
 #define BOOST_TEST_MODULE communicator_allreduce
 
 #include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <thread>
 #include <mpl/mpl.hpp>
 #include "test_helper.hpp"
 
@@ -165,6 +167,171 @@ bool iallreduce_test_with_layout_inplace(F f, const T &val) {
 }
 
 
+// allreduce over a large vector whose elements are generated by g(rank, index)
+template<typename F, typename G>
+bool allreduce_test_generated(F f, G g) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int n{1000};
+  using T = decltype(g(0, 0));
+  mpl::contiguous_layout<T> l(n);
+  std::vector<T> v_x, v_y(n), v_expected;
+  for (int i{0}; i < n; ++i) {
+    v_x.push_back(g(comm_world.rank(), i));
+    v_expected.push_back(g(0, i));
+    for (int r{1}; r < comm_world.size(); ++r)
+      v_expected.back() = f(v_expected.back(), g(r, i));
+  }
+  comm_world.allreduce(f, v_x.data(), v_y.data(), l);
+  return v_y == v_expected;
+}
+
+
+// reduction operation with bulk overload
+template<typename T>
+class bulk_add {
+public:
+  T operator()(const T &a, const T &b) const {
+    return a + b;
+  }
+
+  void operator()(const T *in, T *in_out, int n) const {
+    for (int i{0}; i < n; ++i)
+      in_out[i] = in[i] + in_out[i];
+  }
+};
+
+
+// reduction operation with state, adds an offset to each sum
+template<typename T>
+class offset_add {
+  T offset_;
+
+public:
+  explicit offset_add(T offset) : offset_{offset} {
+  }
+
+  T operator()(const T &a, const T &b) const {
+    return a + b + offset_;
+  }
+};
+
+
+// sum of all ranks plus the offset for each reduction step
+bool stateful_allreduce_result_ok(const mpl::communicator &comm, int offset, int result) {
+  const int size{comm.size()};
+  return result == size * (size - 1) / 2 + (size - 1) * offset;
+}
+
+
+// the persistent request is started several times with varying input data
+template<typename F>
+bool allreduce_init_test(F f, int offset) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  int x{0};
+  int y{0};
+  auto r{comm_world.allreduce_init(f, x, y)};
+  for (int i{0}; i < 3; ++i) {
+    x = comm_world.rank() + i;
+    r.start();
+    r.wait();
+    const int size{comm_world.size()};
+    if (y != size * (size - 1) / 2 + size * i + (size - 1) * offset)
+      return false;
+  }
+  return true;
+}
+
+
+// several persistent requests are started together by a request pool
+bool allreduce_init_pool_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int size{comm_world.size()};
+  std::vector<int> x(3);
+  std::vector<int> y(3);
+  int z{0};
+  int w{0};
+  mpl::prequest_pool pool;
+  pool.push(comm_world.allreduce_init(mpl::plus<int>(), x.data(), y.data(),
+                                      mpl::contiguous_layout<int>(x.size())));
+  pool.push(comm_world.allreduce_init(offset_add<int>(2), z, w));
+  for (int i{0}; i < 2; ++i) {
+    std::fill(x.begin(), x.end(), comm_world.rank() + i);
+    z = comm_world.rank();
+    pool.startall();
+    pool.waitall();
+    for (const int v : y)
+      if (v != size * (size - 1) / 2 + size * i)
+        return false;
+    if (not stateful_allreduce_result_ok(comm_world, 2, w))
+      return false;
+  }
+  return true;
+}
+
+
+// commutative user-defined reduction operation
+template<typename T>
+class commutative_add {
+public:
+  T operator()(const T &a, const T &b) const {
+    return a + b;
+  }
+};
+
+
+template<typename T>
+struct mpl::op_traits<commutative_add<T>> {
+  static constexpr bool is_commutative = true;
+};
+
+
+// associative but non-commutative reduction operation, yields the first operand
+template<typename T>
+class first {
+public:
+  T operator()(const T &a, const T &) const {
+    return a;
+  }
+};
+
+
+template<typename F, typename T>
+bool ring_allreduce_test(F f, const T &val, bool commutative) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int size{comm_world.size()};
+  for (const int n : {0, 1, size - 1, size, 3 * size + 1, 1000})
+    for (const std::size_t chunk_bytes : {std::size_t{0}, sizeof(T), 7 * sizeof(T)}) {
+      const mpl::ring_allreduce policy(chunk_bytes);
+      std::vector<T> v_x(n);
+      for (int j{0}; j < n; ++j) {
+        v_x[j] = val;
+        for (int i{0}; i < comm_world.rank() + j; ++i)
+          ++v_x[j];
+      }
+      std::vector<T> v_expected(n);
+      for (int j{0}; j < n; ++j) {
+        T x{val};
+        for (int i{0}; i < j; ++i)
+          ++x;
+        v_expected[j] = x;
+        if (commutative)
+          for (int r{1}; r < size; ++r) {
+            ++x;
+            v_expected[j] = f(v_expected[j], x);
+          }
+      }
+      std::vector<T> v_y(n);
+      comm_world.allreduce(policy, f, v_x.data(), v_y.data(), mpl::contiguous_layout<T>(n));
+      if (v_y != v_expected)
+        return false;
+      comm_world.allreduce(policy, f, v_x.data(), mpl::contiguous_layout<T>(n));
+      if (v_x != v_expected)
+        return false;
+    }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(allreduce) {
   BOOST_TEST(allreduce_test(add<double>(), 1.0));
   BOOST_TEST(allreduce_test(add<tuple>(), tuple{1, 2.0}));
@@ -172,6 +339,17 @@ BOOST_AUTO_TEST_CASE(allreduce) {
   BOOST_TEST(allreduce_test(mpl::plus<tuple>(), tuple{1, 2.0}));
   BOOST_TEST(allreduce_test([](auto a, auto b) { return a + b; }, 1.0));
   BOOST_TEST(allreduce_test([](auto a, auto b) { return a + b; }, tuple{1, 2.0}));
+  BOOST_TEST(allreduce_test(mpl::plus<int>(), 1));
+  BOOST_TEST(allreduce_test(mpl::multiplies<long>(), 1l));
+  BOOST_TEST(allreduce_test(mpl::max<double>(), 1.0));
+  BOOST_TEST(allreduce_test(mpl::min<unsigned int>(), 1u));
+  BOOST_TEST(allreduce_test(mpl::logical_and<int>(), 1));
+  BOOST_TEST(allreduce_test(mpl::logical_or<int>(), 0));
+  BOOST_TEST(allreduce_test(mpl::logical_xor<int>(), 1));
+  BOOST_TEST(allreduce_test(mpl::bit_and<int>(), 7));
+  BOOST_TEST(allreduce_test(mpl::bit_or<int>(), 1));
+  BOOST_TEST(allreduce_test(mpl::bit_xor<int>(), 1));
+  BOOST_TEST(allreduce_test(mpl::max<char>(), 'a'));
 
   BOOST_TEST(allreduce_test_with_layout(add<double>(), 1.0));
   BOOST_TEST(allreduce_test_with_layout(add<tuple>(), tuple{1, 2.0}));
@@ -225,3 +403,177 @@ BOOST_AUTO_TEST_CASE(allreduce) {
   BOOST_TEST(
       iallreduce_test_with_layout_inplace([](auto a, auto b) { return a + b; }, tuple{1, 2.0}));
 }
+
+
+BOOST_AUTO_TEST_CASE(allreduce_kernels) {
+  static_assert(mpl::detail::has_bulk_apply_v<double, bulk_add<double>>);
+  static_assert(not mpl::detail::has_bulk_apply_v<double, add<double>>);
+
+  BOOST_TEST(allreduce_test_generated(bulk_add<double>(),
+                                      [](int r, int i) { return static_cast<double>(r + i); }));
+  BOOST_TEST(allreduce_test_generated(bulk_add<tuple>(),
+                                      [](int r, int i) { return tuple{r, 0.5 * i}; }));
+  BOOST_TEST(allreduce_test_generated(mpl::plus<std::array<double, 3>>(), [](int r, int i) {
+    return std::array<double, 3>{1.0 * r, 1.0 * i, 1.0 * (r + i)};
+  }));
+  BOOST_TEST(allreduce_test_generated(mpl::multiplies<std::array<int, 2>>(), [](int r, int i) {
+    return std::array<int, 2>{r + 1, i % 3};
+  }));
+  BOOST_TEST(allreduce_test_generated(mpl::plus<std::pair<int, double>>(), [](int r, int i) {
+    return std::pair<int, double>{r, 0.25 * i};
+  }));
+  BOOST_TEST(allreduce_test_generated(
+      mpl::plus<std::tuple<short, float, long>>(), [](int r, int i) {
+        return std::tuple<short, float, long>{static_cast<short>(r), 0.5f * r, i};
+      }));
+  BOOST_TEST(allreduce_test_generated(mpl::max<std::pair<int, int>>(), [](int r, int i) {
+    return std::pair<int, int>{i % 2, r};
+  }));
+}
+
+
+// value-index pairs with ties between processes, indices are ranks
+template<typename T>
+bool allreduce_loc_test() {
+  const auto g{[](int r, int i) {
+    return mpl::value_index<T>{static_cast<T>((r + i) % 3), r};
+  }};
+  return allreduce_test_generated(mpl::min_loc<T>(), g) and
+         allreduce_test_generated(mpl::max_loc<T>(), g);
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_loc) {
+  static_assert(mpl::detail::builtin_op<mpl::value_index<double>,
+                                        mpl::min_loc<double>>::is_available);
+  static_assert(
+      mpl::detail::builtin_op<mpl::value_index<int>, mpl::max_loc<int>>::is_available);
+  static_assert(not mpl::detail::builtin_op<mpl::value_index<unsigned int>,
+                                            mpl::min_loc<unsigned int>>::is_available);
+  BOOST_TEST(mpl::detail::datatype_traits<mpl::value_index<double>>::get_datatype() ==
+             MPI_DOUBLE_INT);
+  BOOST_TEST(mpl::detail::datatype_traits<mpl::value_index<short>>::get_datatype() ==
+             MPI_SHORT_INT);
+
+  BOOST_TEST(allreduce_loc_test<float>());
+  BOOST_TEST(allreduce_loc_test<double>());
+  BOOST_TEST(allreduce_loc_test<long double>());
+  BOOST_TEST(allreduce_loc_test<long>());
+  BOOST_TEST(allreduce_loc_test<int>());
+  BOOST_TEST(allreduce_loc_test<short>());
+  // value types without predefined MPI pair data type
+  BOOST_TEST(allreduce_loc_test<unsigned int>());
+  BOOST_TEST(allreduce_loc_test<long long>());
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_stateful) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  // each reduction uses the state of its own function object
+  for (int offset{1}; offset <= 3; ++offset) {
+    int y{0};
+    comm_world.allreduce(offset_add<int>(offset), comm_world.rank(), y);
+    BOOST_TEST(stateful_allreduce_result_ok(comm_world, offset, y));
+  }
+  // pending non-blocking reductions with different states
+  {
+    int y_1{0}, y_2{0};
+    auto r_1{comm_world.iallreduce(offset_add<int>(10), comm_world.rank(), y_1)};
+    auto r_2{comm_world.iallreduce(offset_add<int>(20), comm_world.rank(), y_2)};
+    r_2.wait();
+    r_1.wait();
+    BOOST_TEST(stateful_allreduce_result_ok(comm_world, 10, y_1));
+    BOOST_TEST(stateful_allreduce_result_ok(comm_world, 20, y_2));
+  }
+  // concurrent reductions from several threads
+  if (mpl::environment::threading_mode() == mpl::threading_modes::multiple) {
+    const int n_threads{4};
+    std::vector<mpl::communicator> comms;
+    for (int i{0}; i < n_threads; ++i)
+      comms.emplace_back(comm_world);
+    std::vector<int> ok(n_threads, 1);
+    std::vector<std::thread> threads;
+    for (int i{0}; i < n_threads; ++i)
+      threads.emplace_back([&, i]() {
+        for (int j{0}; j < 100; ++j) {
+          int y{0};
+          comms[i].allreduce(offset_add<int>(i + j), comms[i].rank(), y);
+          if (not stateful_allreduce_result_ok(comms[i], i + j, y))
+            ok[i] = 0;
+        }
+      });
+    for (auto &thread : threads)
+      thread.join();
+    BOOST_TEST(ok == std::vector<int>(n_threads, 1));
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_persistent) {
+  BOOST_TEST(allreduce_init_test(mpl::plus<int>(), 0));
+  BOOST_TEST(allreduce_init_test([](int a, int b) { return a + b; }, 0));
+  BOOST_TEST(allreduce_init_test(offset_add<int>(3), 3));
+  BOOST_TEST(allreduce_init_pool_test());
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_batch) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  // batch with equal predefined reduction operations only
+  {
+    double x{1.0}, y{2.0};
+    mpl::allreduce_batch batch;
+    batch.add(mpl::plus<double>(), x, x);
+    batch.add(mpl::plus<double>(), y, y);
+    BOOST_TEST(batch.size() == 2);
+    comm_world.allreduce(batch);
+    BOOST_TEST(x == 1.0 * size);
+    BOOST_TEST(y == 2.0 * size);
+  }
+  // batch with different data types and reduction operations
+  {
+    double sum{0};
+    int max{0};
+    tuple t{};
+    bool all{false};
+    int offset_sum{0};
+    mpl::allreduce_batch batch;
+    batch.add(mpl::plus<double>(), 0.5 * rank, sum);
+    batch.add(mpl::max<int>(), rank, max);
+    batch.add(add<tuple>(), tuple{rank, 1.0}, t);
+    batch.add(mpl::logical_and<bool>(), rank >= 0, all);
+    batch.add(offset_add<int>(1), rank, offset_sum);
+    comm_world.allreduce(batch);
+    BOOST_TEST(sum == 0.25 * size * (size - 1));
+    BOOST_TEST(max == size - 1);
+    BOOST_TEST((t == tuple{size * (size - 1) / 2, 1.0 * size}));
+    BOOST_TEST(all);
+    BOOST_TEST(stateful_allreduce_result_ok(comm_world, 1, offset_sum));
+    // non-blocking reduction of the same batch
+    sum = 0;
+    max = 0;
+    auto r{comm_world.iallreduce(batch)};
+    r.wait();
+    BOOST_TEST(sum == 0.25 * size * (size - 1));
+    BOOST_TEST(max == size - 1);
+    BOOST_TEST(stateful_allreduce_result_ok(comm_world, 1, offset_sum));
+  }
+  // empty batch
+  {
+    mpl::allreduce_batch batch;
+    BOOST_TEST(batch.empty());
+    comm_world.allreduce(batch);
+    comm_world.iallreduce(batch).wait();
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_ring) {
+  BOOST_TEST(ring_allreduce_test(mpl::plus<double>(), 1.0, true));
+  BOOST_TEST(ring_allreduce_test(mpl::plus<int>(), 1, true));
+  BOOST_TEST(ring_allreduce_test(commutative_add<double>(), 1.0, true));
+  BOOST_TEST(ring_allreduce_test(commutative_add<tuple>(), tuple{1, 2.0}, true));
+  BOOST_TEST(ring_allreduce_test(first<double>(), 1.0, false));
+}
@@ -2,6 +2,9 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include <mpl/mpl.hpp>
+#include <algorithm>
+#include <optional>
+#include <vector>
 #include "test_helper.hpp"
 
 
@@ -105,6 +108,48 @@ bool alltoallv_without_displacements_test(const T &val) {
 }
 
 
+// the layouts go out of scope before the persistent request is started, the request is
+// started several times
+template<typename T>
+bool alltoallv_init_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int N_processes{comm_world.size()};
+  const int N_send{comm_world.rank() + 1};  // number of elements to send to each process
+  const int N_recv{(N_processes * N_processes + N_processes) /
+                   2};  // total number of elements to receive
+  std::vector<T> send_data;
+  std::vector<T> recv_data(N_recv);
+  std::vector<T> expected;
+  std::optional<mpl::prequest> r;
+  {
+    mpl::layouts<T> sendls;
+    mpl::layouts<T> recvls;
+    T send_val{val};
+    T expected_val{val};
+    for (int i{0}; i < comm_world.rank(); ++i)
+      ++expected_val;
+    for (int j{0}; j < N_processes; ++j) {
+      for (int i{0}; i < N_send; ++i)
+        send_data.push_back(send_val);
+      ++send_val;
+      sendls.push_back(mpl::indexed_layout<T>({{N_send, j * N_send}}));
+      recvls.push_back(mpl::indexed_layout<T>({{j + 1, (j * j + j) / 2}}));
+      for (int i{0}; i < j + 1; ++i)
+        expected.push_back(expected_val);
+    }
+    r.emplace(comm_world.alltoallv_init(send_data.data(), sendls, recv_data.data(), recvls));
+  }
+  for (int i{0}; i < 2; ++i) {
+    std::fill(recv_data.begin(), recv_data.end(), T{});
+    r->start();
+    r->wait();
+    if (recv_data != expected)
+      return false;
+  }
+  return true;
+}
+
+
 template<typename T>
 bool ialltoallv_with_displacements_test(const T &val) {
   const mpl::communicator &comm_world{mpl::environment::comm_world()};
@@ -136,6 +181,9 @@ bool ialltoallv_with_displacements_test(const T &val) {
   }
   auto r{comm_world.ialltoallv(send_data.data(), sendls, senddispls, recv_data.data(), recvls,
                                recvdispls)};
+  // layouts must not be required to outlive the request
+  sendls = mpl::layouts<T>();
+  recvls = mpl::layouts<T>();
   r.wait();
   return recv_data == expected;
 }
@@ -322,6 +370,140 @@ bool ialltoallv_in_place_without_displacements_test(const T &val) {
 }
 
 
+// block of data that is sent from the process with rank source to the process with rank
+// dest, some blocks are empty
+template<typename T>
+std::vector<T> container_alltoallv_block(const T &val, int source, int dest, int size) {
+  T x{val};
+  for (int i{0}; i < source * size + dest; ++i)
+    ++x;
+  return std::vector<T>((source + dest) % 3, x);
+}
+
+
+template<typename T>
+std::vector<std::vector<T>> container_alltoallv_send_data(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  std::vector<std::vector<T>> send_data;
+  for (int i{0}; i < comm_world.size(); ++i)
+    send_data.push_back(
+        container_alltoallv_block(val, comm_world.rank(), i, comm_world.size()));
+  return send_data;
+}
+
+
+template<typename T>
+bool container_alltoallv_result_ok(const T &val, const mpl::csr_vector<T> &recv_data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (static_cast<int>(recv_data.size()) != comm_world.size())
+    return false;
+  for (int i{0}; i < comm_world.size(); ++i) {
+    const auto expected{
+        container_alltoallv_block(val, i, comm_world.rank(), comm_world.size())};
+    if (not std::equal(recv_data.begin(i), recv_data.end(i), expected.begin(), expected.end()))
+      return false;
+  }
+  return recv_data.offsets().back() == recv_data.values().size();
+}
+
+
+// flattens containers into a single vector and offsets of the blocks
+template<typename T>
+void container_alltoallv_flatten(const std::vector<std::vector<T>> &data,
+                                 std::vector<T> &values, std::vector<std::size_t> &offsets) {
+  offsets.assign(1, 0);
+  for (const auto &block : data) {
+    values.insert(values.end(), block.begin(), block.end());
+    offsets.push_back(values.size());
+  }
+}
+
+
+template<typename T>
+bool alltoallv_container_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const auto send_data{container_alltoallv_send_data(val)};
+  mpl::csr_vector<T> recv_data;
+  comm_world.alltoallv(send_data, recv_data);
+  if (not container_alltoallv_result_ok(val, recv_data))
+    return false;
+  // the receive buffer is reused
+  comm_world.alltoallv(send_data, recv_data);
+  return container_alltoallv_result_ok(val, recv_data);
+}
+
+
+template<typename T>
+bool alltoallv_offsets_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  std::vector<T> values;
+  std::vector<std::size_t> offsets;
+  container_alltoallv_flatten(container_alltoallv_send_data(val), values, offsets);
+  mpl::csr_vector<T> recv_data;
+  comm_world.alltoallv(values, offsets, recv_data);
+  return container_alltoallv_result_ok(val, recv_data);
+}
+
+
+template<typename T>
+bool ialltoallv_container_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  auto send_data{container_alltoallv_send_data(val)};
+  mpl::csr_vector<T> recv_data;
+  auto r{comm_world.ialltoallv(send_data, recv_data)};
+  // send data is copied and may be modified
+  send_data.clear();
+  r.wait();
+  return container_alltoallv_result_ok(val, recv_data);
+}
+
+
+// several non-blocking all-to-all exchanges of containers are pending at the same time
+bool ialltoallv_pending_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  std::vector<std::vector<double>> send_data_1;
+  std::vector<std::vector<int>> send_data_2;
+  for (int i{0}; i < comm_world.size(); ++i) {
+    send_data_1.emplace_back(100000 + i, comm_world.rank() + 1.0);
+    send_data_2.emplace_back(150000 + i, comm_world.rank() + 2);
+  }
+  mpl::csr_vector<double> recv_data_1;
+  mpl::csr_vector<int> recv_data_2;
+  auto r_1{comm_world.ialltoallv(send_data_1, recv_data_1)};
+  auto r_2{comm_world.ialltoallv(send_data_2, recv_data_2)};
+  auto r_3{comm_world.ibarrier()};
+  r_1.wait();
+  r_2.wait();
+  r_3.wait();
+  if (static_cast<int>(recv_data_1.size()) != comm_world.size() or
+      static_cast<int>(recv_data_2.size()) != comm_world.size())
+    return false;
+  for (int i{0}; i < comm_world.size(); ++i) {
+    const std::vector<double> expected_1(100000 + comm_world.rank(), i + 1.0);
+    const std::vector<int> expected_2(150000 + comm_world.rank(), i + 2);
+    if (not std::equal(recv_data_1.begin(i), recv_data_1.end(i), expected_1.begin(),
+                       expected_1.end()) or
+        not std::equal(recv_data_2.begin(i), recv_data_2.end(i), expected_2.begin(),
+                       expected_2.end()))
+      return false;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool ialltoallv_offsets_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  std::vector<T> values;
+  std::vector<std::size_t> offsets;
+  container_alltoallv_flatten(container_alltoallv_send_data(val), values, offsets);
+  mpl::csr_vector<T> recv_data;
+  auto r{comm_world.ialltoallv(values, offsets, recv_data)};
+  r.wait();
+  return container_alltoallv_result_ok(val, recv_data);
+}
+
+
 BOOST_AUTO_TEST_CASE(alltoallv) {
   BOOST_TEST(alltoallv_with_displacements_test(1.0));
   BOOST_TEST(alltoallv_with_displacements_test(tuple{1, 2.0}));
@@ -355,4 +537,17 @@ BOOST_AUTO_TEST_CASE(alltoallv) {
   BOOST_TEST(ialltoallv_in_place_without_displacements_test(1.0));
   BOOST_TEST(ialltoallv_in_place_without_displacements_test(tuple{1, 2.0}));
 #endif
+
+  BOOST_TEST(alltoallv_init_test(1.0));
+  BOOST_TEST(alltoallv_init_test(tuple{1, 2.0}));
+
+  BOOST_TEST(alltoallv_container_test(1.0));
+  BOOST_TEST(alltoallv_container_test(tuple{1, 2.0}));
+  BOOST_TEST(alltoallv_offsets_test(1.0));
+  BOOST_TEST(alltoallv_offsets_test(tuple{1, 2.0}));
+  BOOST_TEST(ialltoallv_container_test(1.0));
+  BOOST_TEST(ialltoallv_container_test(tuple{1, 2.0}));
+  BOOST_TEST(ialltoallv_pending_test());
+  BOOST_TEST(ialltoallv_offsets_test(1.0));
+  BOOST_TEST(ialltoallv_offsets_test(tuple{1, 2.0}));
 }
@@ -1,6 +1,14 @@
 #define BOOST_TEST_MODULE communicator_bcast
 
 #include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <list>
+#include <map>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
 #include <mpl/mpl.hpp>
 
 
@@ -58,6 +66,42 @@ bool ibcast_test(const std::vector<T> &send, const std::vector<T> &expected,
 }
 
 
+// the persistent request is started several times, the buffer is modified in between
+template<typename T>
+bool bcast_init_test(const T &val, const T &other_val) {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  T x{};
+  auto r{comm_world.bcast_init(0, x)};
+  for (const T &v : {val, other_val}) {
+    x = comm_world.rank() == 0 ? v : T{};
+    r.start();
+    r.wait();
+    if (not(x == v))
+      return false;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool bcast_init_test(const std::vector<T> &send, const std::vector<T> &expected,
+                     const mpl::layout<T> &l) {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  std::vector<T> x(send.size(), {});
+  auto r{comm_world.bcast_init(0, x.data(), l)};
+  for (int i{0}; i < 2; ++i) {
+    std::fill(x.begin(), x.end(), T{});
+    if (comm_world.rank() == 0)
+      x = send;
+    r.start();
+    r.wait();
+    if (x != (comm_world.rank() == 0 ? send : expected))
+      return false;
+  }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(bcast) {
   BOOST_TEST(bcast_test(1.0));
   BOOST_TEST(bcast_test(std::array{1, 2, 3, 4}));
@@ -68,4 +112,64 @@ BOOST_AUTO_TEST_CASE(bcast) {
   BOOST_TEST(ibcast_test(std::array{1, 2, 3, 4}));
   BOOST_TEST(ibcast_test(std::vector{1, 2, 3, 4, 5, 6}, std::vector{0, 2, 3, 0, 5, 0},
                          mpl::indexed_layout<int>{{{2, 1}, {1, 4}}}));
+
+  BOOST_TEST(bcast_init_test(1.0, 2.0));
+  BOOST_TEST(bcast_init_test(std::array{1, 2, 3, 4}, std::array{5, 6, 7, 8}));
+  BOOST_TEST(bcast_init_test(std::vector{1, 2, 3, 4, 5, 6}, std::vector{0, 2, 3, 0, 5, 0},
+                             mpl::indexed_layout<int>{{{2, 1}, {1, 4}}}));
+}
+
+
+// several non-blocking broadcasts of large containers are pending at the same time
+bool ibcast_pending_test() {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  std::vector<double> expected_1(200000);
+  std::iota(expected_1.begin(), expected_1.end(), 1.0);
+  std::vector<double> expected_2(300000);
+  std::iota(expected_2.begin(), expected_2.end(), 2.0);
+  std::list<int> expected_3(100000);
+  std::iota(expected_3.begin(), expected_3.end(), 3);
+  std::vector<double> x_1;
+  std::vector<double> x_2;
+  std::list<int> x_3;
+  if (comm_world.rank() == 0) {
+    x_1 = expected_1;
+    x_2 = expected_2;
+    x_3 = expected_3;
+  }
+  auto r_1{comm_world.ibcast(0, x_1)};
+  auto r_2{comm_world.ibcast(0, x_2)};
+  auto r_3{comm_world.ibcast(0, x_3)};
+  auto r_4{comm_world.ibarrier()};
+  r_1.wait();
+  r_2.wait();
+  r_3.wait();
+  r_4.wait();
+  return x_1 == expected_1 and x_2 == expected_2 and x_3 == expected_3;
+}
+
+
+BOOST_AUTO_TEST_CASE(bcast_container) {
+  std::vector<double> large(300000);
+  for (std::size_t i{0}; i < large.size(); ++i)
+    large[i] = static_cast<double>(i);
+
+  BOOST_TEST(bcast_test(std::vector<int>{}));
+  BOOST_TEST(bcast_test(std::vector{1, 2, 3, 4, 5, 6}));
+  BOOST_TEST(bcast_test(large));
+  BOOST_TEST(bcast_test(std::string{"Hello World!"}));
+  BOOST_TEST(bcast_test(std::string(100000, 'x')));
+  BOOST_TEST(bcast_test(std::vector<bool>{true, false, true}));
+  BOOST_TEST(bcast_test(std::list{1.0, 2.0, 3.0}));
+  BOOST_TEST(bcast_test(std::set{3, 1, 2}));
+  BOOST_TEST(bcast_test(std::map<int, double>{{1, 1.0}, {2, 2.0}}));
+
+  BOOST_TEST(ibcast_test(std::vector<int>{}));
+  BOOST_TEST(ibcast_test(std::vector{1, 2, 3, 4, 5, 6}));
+  BOOST_TEST(ibcast_test(large));
+  BOOST_TEST(ibcast_test(std::string{"Hello World!"}));
+  BOOST_TEST(ibcast_test(std::string(100000, 'x')));
+  BOOST_TEST(ibcast_test(std::list{1.0, 2.0, 3.0}));
+  BOOST_TEST(ibcast_test(std::map<int, double>{{1, 1.0}, {2, 2.0}}));
+  BOOST_TEST(ibcast_pending_test());
 }
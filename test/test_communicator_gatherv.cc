@@ -2,7 +2,9 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include <mpl/mpl.hpp>
+#include <algorithm>
 #include <tuple>
+#include <vector>
 #include "test_helper.hpp"
 
 
@@ -144,6 +146,89 @@ bool igatherv_contiguous_test(const T &val) {
 }
 
 
+// rank i contributes i copies of val incremented i times
+template<typename T>
+std::vector<T> container_gatherv_send_data(const T &val, int rank) {
+  T x{val};
+  for (int i{0}; i < rank; ++i)
+    ++x;
+  return std::vector<T>(rank, x);
+}
+
+
+template<typename T>
+bool container_gatherv_result_ok(const T &val, const mpl::csr_vector<T> &recv_data, int size) {
+  if (static_cast<int>(recv_data.size()) != size)
+    return false;
+  for (int i{0}; i < size; ++i) {
+    const auto expected{container_gatherv_send_data(val, i)};
+    if (not std::equal(recv_data.begin(i), recv_data.end(i), expected.begin(), expected.end()))
+      return false;
+  }
+  return recv_data.offsets().back() == recv_data.values().size();
+}
+
+
+template<typename T>
+bool gatherv_container_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int root{comm_world.size() - 1};
+  const auto send_data{container_gatherv_send_data(val, comm_world.rank())};
+  mpl::csr_vector<T> recv_data;
+  comm_world.gatherv(root, send_data, recv_data);
+  if (comm_world.rank() == root)
+    return container_gatherv_result_ok(val, recv_data, comm_world.size());
+  return recv_data.empty();
+}
+
+
+template<typename T>
+bool igatherv_container_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int root{comm_world.size() - 1};
+  const auto send_data{container_gatherv_send_data(val, comm_world.rank())};
+  mpl::csr_vector<T> recv_data;
+  auto r{comm_world.igatherv(root, send_data, recv_data)};
+  r.wait();
+  if (comm_world.rank() == root)
+    return container_gatherv_result_ok(val, recv_data, comm_world.size());
+  return recv_data.empty();
+}
+
+
+// several non-blocking gathers of containers are pending at the same time
+bool igatherv_pending_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int root{comm_world.size() - 1};
+  const int rank{comm_world.rank()};
+  const std::vector<double> send_data_1(200000 + rank, rank + 1.0);
+  const std::vector<int> send_data_2(300000 + rank, rank + 2);
+  mpl::csr_vector<double> recv_data_1;
+  mpl::csr_vector<int> recv_data_2;
+  auto r_1{comm_world.igatherv(root, send_data_1, recv_data_1)};
+  auto r_2{comm_world.igatherv(root, send_data_2, recv_data_2)};
+  auto r_3{comm_world.ibarrier()};
+  r_1.wait();
+  r_2.wait();
+  r_3.wait();
+  if (rank != root)
+    return recv_data_1.empty() and recv_data_2.empty();
+  if (static_cast<int>(recv_data_1.size()) != comm_world.size() or
+      static_cast<int>(recv_data_2.size()) != comm_world.size())
+    return false;
+  for (int i{0}; i < comm_world.size(); ++i) {
+    const std::vector<double> expected_1(200000 + i, i + 1.0);
+    const std::vector<int> expected_2(300000 + i, i + 2);
+    if (not std::equal(recv_data_1.begin(i), recv_data_1.end(i), expected_1.begin(),
+                       expected_1.end()) or
+        not std::equal(recv_data_2.begin(i), recv_data_2.end(i), expected_2.begin(),
+                       expected_2.end()))
+      return false;
+  }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(gatherv) {
   BOOST_TEST(gatherv_test<use_non_root_overload::no>(1.0));
   BOOST_TEST(gatherv_test<use_non_root_overload::no>(tuple{1, 2.0}));
@@ -171,4 +256,10 @@ BOOST_AUTO_TEST_CASE(gatherv) {
 
   BOOST_TEST(igatherv_contiguous_test<use_non_root_overload::yes>(1.0));
   BOOST_TEST(igatherv_contiguous_test<use_non_root_overload::yes>(tuple{1, 2.0}));
+
+  BOOST_TEST(gatherv_container_test(1.0));
+  BOOST_TEST(gatherv_container_test(tuple{1, 2.0}));
+  BOOST_TEST(igatherv_container_test(1.0));
+  BOOST_TEST(igatherv_container_test(tuple{1, 2.0}));
+  BOOST_TEST(igatherv_pending_test());
 }
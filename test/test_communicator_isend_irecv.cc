@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <deque>
+#include <numeric>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -14,6 +16,31 @@
 #include "test_helper.hpp"
 
 
+// large STL containers, which are sent in place (deque and list of large elements) or copied
+// into a contiguous buffer (set of small elements)
+std::deque<double> large_deque() {
+  std::deque<double> data(100000);
+  std::iota(data.begin(), data.end(), 1.0);
+  return data;
+}
+
+
+std::list<std::array<double, 64>> large_list() {
+  std::list<std::array<double, 64>> data;
+  for (int i{0}; i < 300; ++i)
+    data.push_back(std::array<double, 64>{1.0 * i});
+  return data;
+}
+
+
+std::set<int> large_set() {
+  std::set<int> data;
+  for (int i{0}; i < 100000; ++i)
+    data.insert(3 * i);
+  return data;
+}
+
+
 template<typename T>
 bool isend_irecv_test(const T &data) {
   const mpl::communicator &comm_world = mpl::environment::comm_world();
@@ -34,6 +61,26 @@ bool isend_irecv_test(const T &data) {
 }
 
 
+// the sent container is destroyed before the non-blocking send operation has been completed
+template<typename T>
+bool isend_temporary_irecv_test(const T &data) {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0) {
+    auto r{comm_world.isend(T(data), 1)};
+    r.wait();
+  }
+  if (comm_world.rank() == 1) {
+    T data_r;
+    auto r{comm_world.irecv(data_r, 0)};
+    r.wait();
+    return data_r == data;
+  }
+  return true;
+}
+
+
 template<typename T>
 bool isend_irecv_iter_test(const T &data) {
   const mpl::communicator &comm_world = mpl::environment::comm_world();
@@ -304,6 +351,11 @@ BOOST_AUTO_TEST_CASE(isend_irecv) {
   BOOST_TEST(isend_irecv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(isend_irecv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(isend_irecv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(isend_irecv_test(large_deque()));
+  BOOST_TEST(isend_irecv_test(large_list()));
+  BOOST_TEST(isend_irecv_test(large_set()));
+  BOOST_TEST(isend_temporary_irecv_test(large_deque()));
+  BOOST_TEST(isend_temporary_irecv_test(large_list()));
   // iterators
   BOOST_TEST(isend_irecv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(isend_irecv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -400,6 +452,9 @@ BOOST_AUTO_TEST_CASE(issend_irecv) {
   BOOST_TEST(issend_irecv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(issend_irecv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(issend_irecv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(issend_irecv_test(large_deque()));
+  BOOST_TEST(issend_irecv_test(large_list()));
+  BOOST_TEST(issend_irecv_test(large_set()));
   // iterators
   BOOST_TEST(issend_irecv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(issend_irecv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -448,9 +503,95 @@ BOOST_AUTO_TEST_CASE(irsend_irecv) {
   BOOST_TEST(irsend_irecv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(irsend_irecv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(irsend_irecv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(irsend_irecv_test(large_deque()));
+  BOOST_TEST(irsend_irecv_test(large_list()));
+  BOOST_TEST(irsend_irecv_test(large_set()));
   // iterators
   BOOST_TEST(irsend_irecv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(irsend_irecv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(irsend_irecv_iter_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(irsend_irecv_iter_test(std::set<int>{1, 2, 3, 4, 5}));
 }
+
+
+template<typename T>
+bool isend_irecv_pool_test(const T &data, int n) {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0) {
+    mpl::irequest_pool r;
+    for (int i{0}; i < n; ++i)
+      r.push(comm_world.isend(data, 1, mpl::tag_t{i}));
+    r.waitall();
+  }
+  if (comm_world.rank() == 1) {
+    std::vector<T> data_r(n);
+    mpl::irequest_pool r;
+    for (int i{0}; i < n; ++i)
+      r.push(comm_world.irecv(data_r[i], 0, mpl::tag_t{n - 1 - i}));
+    while (r.waitany().first == mpl::test_result::completed) {
+    }
+    for (const auto &d : data_r)
+      if (d != data)
+        return false;
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(isend_irecv_pool) {
+  BOOST_TEST(isend_irecv_pool_test(std::list<int>{1, 2, 3, 4, 5}, 1000));
+  BOOST_TEST(isend_irecv_pool_test(std::set<int>{1, 2, 3, 4, 5}, 100));
+  BOOST_TEST(isend_irecv_pool_test(std::vector<int>{1, 2, 3, 4, 5}, 100));
+}
+
+
+BOOST_AUTO_TEST_CASE(irecv_cancel) {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  std::list<int> data;
+  auto r{comm_world.irecv(data, comm_world.rank(), mpl::tag_t{1})};
+  r.cancel();
+  const auto s{r.wait()};
+  BOOST_TEST(s.is_cancelled());
+}
+
+
+template<typename T>
+bool irecv_variable_size_test(int n) {
+  const mpl::communicator &comm_world = mpl::environment::comm_world();
+  if (comm_world.size() < 2)
+    return false;
+  using value_type = typename T::value_type;
+  std::vector<T> data;
+  for (int i{0}; i < n; ++i)
+    data.emplace_back(i, static_cast<value_type>('A' + i % 26));
+  if (comm_world.rank() == 0) {
+    mpl::irequest_pool r;
+    for (int i{0}; i < n; ++i)
+      r.push(comm_world.isend(data[i], 1, mpl::tag_t{i}));
+    r.waitall();
+  }
+  if (comm_world.rank() == 1) {
+    std::vector<T> data_r(n);
+    mpl::irequest_pool r;
+    for (int i{0}; i < n; ++i)
+      r.push(comm_world.irecv(data_r[i], 0, mpl::tag_t{i}));
+    std::size_t completed{0};
+    while (true) {
+      const auto [result, indices]{r.waitsome()};
+      if (result == mpl::test_result::no_active_requests)
+        break;
+      completed += indices.size();
+    }
+    return completed == static_cast<std::size_t>(n) and data_r == data;
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(irecv_variable_size) {
+  BOOST_TEST(irecv_variable_size_test<std::vector<int>>(500));
+  BOOST_TEST(irecv_variable_size_test<std::string>(500));
+  BOOST_TEST(irecv_variable_size_test<std::wstring>(100));
+}
@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <deque>
+#include <numeric>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -16,6 +18,31 @@
 #include "test_helper.hpp"
 
 
+// large STL containers, which are sent in place (deque and list of large elements) or copied
+// into a contiguous buffer (set of small elements)
+std::deque<double> large_deque() {
+  std::deque<double> data(100000);
+  std::iota(data.begin(), data.end(), 1.0);
+  return data;
+}
+
+
+std::list<std::array<double, 64>> large_list() {
+  std::list<std::array<double, 64>> data;
+  for (int i{0}; i < 300; ++i)
+    data.push_back(std::array<double, 64>{1.0 * i});
+  return data;
+}
+
+
+std::set<int> large_set() {
+  std::set<int> data;
+  for (int i{0}; i < 100000; ++i)
+    data.insert(3 * i);
+  return data;
+}
+
+
 #if __cplusplus >= 202002L
 #include <span>
 
@@ -350,6 +377,9 @@ BOOST_AUTO_TEST_CASE(send_recv) {
   BOOST_TEST(send_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(send_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(send_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(send_recv_test(large_deque()));
+  BOOST_TEST(send_recv_test(large_list()));
+  BOOST_TEST(send_recv_test(large_set()));
   // iterators
   BOOST_TEST(send_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(send_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -460,6 +490,9 @@ BOOST_AUTO_TEST_CASE(ssend_recv) {
   BOOST_TEST(ssend_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(ssend_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(ssend_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(ssend_recv_test(large_deque()));
+  BOOST_TEST(ssend_recv_test(large_list()));
+  BOOST_TEST(ssend_recv_test(large_set()));
   // iterators
   BOOST_TEST(ssend_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(ssend_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -515,6 +548,9 @@ BOOST_AUTO_TEST_CASE(rsend_recv) {
   BOOST_TEST(rsend_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(rsend_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(rsend_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(rsend_recv_test(large_deque()));
+  BOOST_TEST(rsend_recv_test(large_list()));
+  BOOST_TEST(rsend_recv_test(large_set()));
   // iterators
   BOOST_TEST(rsend_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(rsend_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
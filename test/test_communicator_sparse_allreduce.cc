@@ -0,0 +1,75 @@
+#define BOOST_TEST_MODULE communicator_sparse_allreduce
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <map>
+#include <vector>
+#include "test_helper.hpp"
+
+
+// associative but non-commutative reduction operation, yields the first operand
+template<typename T>
+class first {
+public:
+  T operator()(const T &a, const T &) const {
+    return a;
+  }
+};
+
+
+// sparse vector of the given process, process r holds every (r + 2)-th element and
+// element 0, element 1 is given twice
+template<typename T>
+std::vector<mpl::value_index<T>> sparse_allreduce_data(const T &val, int rank, int n,
+                                                       int stride) {
+  std::vector<mpl::value_index<T>> data;
+  for (int i{n - 1}; i >= 0; --i)
+    if (i % (stride * (rank + 2)) == 0 or i == 1) {
+      T x{val};
+      for (int j{0}; j < i % 7 + rank; ++j)
+        ++x;
+      data.push_back({x, i});
+    }
+  if (n > 1)
+    data.push_back(data.back());
+  return data;
+}
+
+
+template<typename F, typename T>
+bool sparse_allreduce_test(F f, const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  for (const int n : {0, 1, 10, 1000})
+    for (const int stride : {1, 3})
+      for (const double fill_ratio : {-1.0, 0.0, 0.05, 0.5, 2.0}) {
+        std::map<int, T> expected;
+        for (int r{0}; r < comm_world.size(); ++r)
+          for (const auto &entry : sparse_allreduce_data(val, r, n, stride)) {
+            auto i{expected.find(entry.index)};
+            if (i == expected.end())
+              expected[entry.index] = entry.value;
+            else
+              i->second = f(i->second, entry.value);
+          }
+        std::vector<mpl::value_index<T>> expected_data;
+        for (const auto &[index, value] : expected)
+          expected_data.push_back({value, index});
+        std::vector<mpl::value_index<T>> recv_data{{val, -1}};
+        const auto send_data{sparse_allreduce_data(val, comm_world.rank(), n, stride)};
+        if (fill_ratio < 0)
+          comm_world.sparse_allreduce(f, n, send_data, recv_data);
+        else
+          comm_world.sparse_allreduce(f, n, send_data, recv_data, fill_ratio);
+        if (recv_data != expected_data)
+          return false;
+      }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(sparse_allreduce) {
+  BOOST_TEST(sparse_allreduce_test(mpl::plus<double>(), 1.0));
+  BOOST_TEST(sparse_allreduce_test(mpl::max<int>(), 1));
+  BOOST_TEST(sparse_allreduce_test(add<tuple>(), tuple{1, 2.0}));
+  BOOST_TEST(sparse_allreduce_test(first<double>(), 1.0));
+}
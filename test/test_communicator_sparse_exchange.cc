@@ -0,0 +1,50 @@
+#define BOOST_TEST_MODULE communicator_sparse_exchange
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <map>
+#include <numeric>
+#include <vector>
+#include "test_helper.hpp"
+
+
+// data that is sent by the given process in the given round
+template<typename T>
+std::vector<T> sparse_exchange_data(const T &val, int rank, int round) {
+  std::vector<T> data(rank + round);
+  std::iota(begin(data), end(data), val);
+  return data;
+}
+
+
+// each process sends data to its next and its third next neighbour, process 0 sends no data
+// in odd rounds, all exchanges use the same communicator to test consecutive exchanges
+template<typename T>
+bool sparse_exchange_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  for (int round{0}; round < 4; ++round) {
+    std::map<int, std::vector<T>> send_data;
+    if (rank != 0 or round % 2 == 0)
+      for (const int k : {1, 3})
+        send_data[(rank + k) % size] = sparse_exchange_data(val, rank, round);
+    std::map<int, std::vector<T>> recv_data;
+    comm_world.sparse_exchange(send_data, recv_data);
+    std::map<int, std::vector<T>> expected;
+    for (int source{0}; source < size; ++source)
+      if (source != 0 or round % 2 == 0)
+        for (const int k : {1, 3})
+          if ((source + k) % size == rank)
+            expected[source] = sparse_exchange_data(val, source, round);
+    if (recv_data != expected)
+      return false;
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(sparse_exchange) {
+  BOOST_TEST(sparse_exchange_test(1.0));
+  BOOST_TEST(sparse_exchange_test(tuple{1, 2.0}));
+}
@@ -0,0 +1,131 @@
+#define BOOST_TEST_MODULE hierarchical_communicator
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "test_helper.hpp"
+
+
+// groupings of processes into nodes, the processes of a node have non-consecutive ranks for
+// the last grouping
+std::vector<mpl::hierarchical_communicator> hierarchical_communicators() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  std::vector<mpl::hierarchical_communicator> comms;
+  comms.emplace_back(comm_world);
+  comms.emplace_back(comm_world, comm_world.rank() / 2);
+  comms.emplace_back(comm_world, comm_world.rank() % 2);
+  return comms;
+}
+
+
+bool barrier_test() {
+  for (const auto &comm : hierarchical_communicators()) {
+    if (comm.node_communicator().size() + comm.num_nodes() - 1 > comm.size())
+      return false;
+    comm.barrier();
+  }
+  return true;
+}
+
+
+template<typename T>
+bool bcast_test(const T &val) {
+  for (const auto &comm : hierarchical_communicators())
+    for (int root{0}; root < comm.size(); ++root) {
+      T expected{val};
+      for (int i{0}; i < root; ++i)
+        ++expected;
+      T x{comm.rank() == root ? expected : T{}};
+      comm.bcast(root, x);
+      if (not(x == expected))
+        return false;
+      std::vector<T> v(3, comm.rank() == root ? expected : T{});
+      comm.bcast(root, v.data(), mpl::vector_layout<T>(v.size()));
+      if (v != std::vector<T>(3, expected))
+        return false;
+    }
+  return true;
+}
+
+
+template<typename T>
+bool allgather_test(const T &val) {
+  for (const auto &comm : hierarchical_communicators()) {
+    std::vector<T> expected(comm.size());
+    std::iota(begin(expected), end(expected), val);
+    std::vector<T> v(comm.size());
+    comm.allgather(expected[comm.rank()], v.data());
+    if (v != expected)
+      return false;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool allgatherv_test(const T &val) {
+  for (const auto &comm : hierarchical_communicators()) {
+    // process i contributes i + 1 elements, blocks are stored in reverse order
+    mpl::contiguous_layouts<T> ls;
+    mpl::displacements displs(comm.size());
+    int offset{0};
+    for (int i{comm.size() - 1}; i >= 0; --i) {
+      displs[i] = sizeof(T) * offset;
+      offset += i + 1;
+    }
+    for (int i{0}; i < comm.size(); ++i)
+      ls.push_back(mpl::contiguous_layout<T>(i + 1));
+    std::vector<T> expected(offset);
+    std::iota(begin(expected), end(expected), val);
+    std::vector<T> v(offset);
+    const int rank{comm.rank()};
+    comm.allgatherv(expected.data() + displs[rank] / sizeof(T), ls[rank], v.data(), ls,
+                    displs);
+    if (v != expected)
+      return false;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool allreduce_test(const T &val) {
+  for (const auto &comm : hierarchical_communicators()) {
+    T x{val};
+    for (int i{0}; i < comm.rank(); ++i)
+      ++x;
+    T expected{};
+    T y{val};
+    for (int i{0}; i < comm.size(); ++i, ++y)
+      expected = expected + y;
+    T result;
+    comm.allreduce(add<T>(), x, result);
+    if (not(result == expected))
+      return false;
+    std::vector<T> v(5, x);
+    std::vector<T> results(5);
+    comm.allreduce(add<T>(), v.data(), results.data(), mpl::contiguous_layout<T>(v.size()));
+    if (results != std::vector<T>(5, expected))
+      return false;
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(hierarchical_communicator) {
+  BOOST_TEST(barrier_test());
+
+  BOOST_TEST(bcast_test(1.0));
+  BOOST_TEST(bcast_test(tuple{1, 2.0}));
+
+  BOOST_TEST(allgather_test(1.0));
+  BOOST_TEST(allgather_test(tuple{1, 2.0}));
+
+  BOOST_TEST(allgatherv_test(1.0));
+  BOOST_TEST(allgatherv_test(tuple{1, 2.0}));
+
+  BOOST_TEST(allreduce_test(1.0));
+  BOOST_TEST(allreduce_test(tuple{1, 2.0}));
+}
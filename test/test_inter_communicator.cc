@@ -2,8 +2,84 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include <mpl/mpl.hpp>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
+
+// collective operations on containers that are implemented for communicators only
+template<typename C, typename = void>
+struct has_container_allgatherv : std::false_type {};
+
+template<typename C>
+struct has_container_allgatherv<
+    C, std::void_t<decltype(std::declval<const C &>().allgatherv(
+           std::declval<const std::vector<int> &>(), std::declval<mpl::csr_vector<int> &>()))>>
+    : std::true_type {};
+
+template<typename C, typename = void>
+struct has_container_gatherv : std::false_type {};
+
+template<typename C>
+struct has_container_gatherv<
+    C, std::void_t<decltype(std::declval<const C &>().gatherv(
+           0, std::declval<const std::vector<int> &>(), std::declval<mpl::csr_vector<int> &>()))>>
+    : std::true_type {};
+
+template<typename C, typename = void>
+struct has_ring_allreduce : std::false_type {};
+
+template<typename C>
+struct has_ring_allreduce<
+    C, std::void_t<decltype(std::declval<const C &>().allreduce(
+           mpl::ring_allreduce{}, mpl::plus<double>(), std::declval<const double *>(),
+           std::declval<double *>(), std::declval<const mpl::contiguous_layout<double> &>()))>>
+    : std::true_type {};
+
+template<typename C, typename = void>
+struct has_in_place_ring_allreduce : std::false_type {};
+
+template<typename C>
+struct has_in_place_ring_allreduce<
+    C, std::void_t<decltype(std::declval<const C &>().allreduce(
+           mpl::ring_allreduce{}, mpl::plus<double>(), std::declval<double *>(),
+           std::declval<const mpl::contiguous_layout<double> &>()))>>
+    : std::true_type {};
+
+template<typename C, typename = void>
+struct has_sparse_allreduce : std::false_type {};
+
+template<typename C>
+struct has_sparse_allreduce<
+    C, std::void_t<decltype(std::declval<const C &>().sparse_allreduce(
+           mpl::plus<double>(), 0, std::declval<const std::vector<mpl::value_index<double>> &>(),
+           std::declval<std::vector<mpl::value_index<double>> &>()))>> : std::true_type {};
+
+template<typename C, typename = void>
+struct has_serialized_gatherv : std::false_type {};
+
+template<typename C>
+struct has_serialized_gatherv<
+    C, std::void_t<decltype(std::declval<const C &>().gatherv(
+           0, std::declval<const std::vector<std::string> &>(),
+           std::declval<std::vector<std::vector<std::string>> &>()))>> : std::true_type {};
+
+static_assert(has_container_allgatherv<mpl::communicator>::value);
+static_assert(not has_container_allgatherv<mpl::inter_communicator>::value);
+static_assert(has_container_gatherv<mpl::communicator>::value);
+static_assert(not has_container_gatherv<mpl::inter_communicator>::value);
+static_assert(has_ring_allreduce<mpl::communicator>::value);
+static_assert(not has_ring_allreduce<mpl::inter_communicator>::value);
+static_assert(has_in_place_ring_allreduce<mpl::communicator>::value);
+static_assert(not has_in_place_ring_allreduce<mpl::inter_communicator>::value);
+static_assert(has_sparse_allreduce<mpl::communicator>::value);
+static_assert(not has_sparse_allreduce<mpl::inter_communicator>::value);
+static_assert(has_serialized_gatherv<mpl::communicator>::value);
+static_assert(not has_serialized_gatherv<mpl::inter_communicator>::value);
+
 // test inter-communicator creation
 BOOST_AUTO_TEST_CASE(inter_communicator_create) {
   const mpl::communicator &comm_world{mpl::environment::comm_world()};
@@ -49,3 +125,84 @@ BOOST_AUTO_TEST_CASE(inter_communicator_merge) {
   BOOST_TEST((communicator_equality == mpl::communicator::congruent or
               communicator_equality == mpl::communicator::similar));
 }
+
+
+// test broadcast of STL containers via an inter-communicator, process 0 of the group of
+// processes with even rank in comm_world is the root
+template<typename T>
+bool inter_communicator_bcast_test(const T &data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  const int my_group{comm_world.rank() % 2};
+  mpl::communicator local_communicator{mpl::communicator::split, comm_world, my_group};
+  mpl::inter_communicator inter_comm{local_communicator, 0, comm_world, my_group == 0 ? 1 : 0};
+  const bool is_root{my_group == 0 and inter_comm.rank() == 0};
+  const int root_rank{my_group == 0 ? (is_root ? mpl::root : mpl::proc_null) : 0};
+  // processes of the root group, which do not provide the data, receive nothing
+  const T expected{my_group == 0 and not is_root ? T{} : data};
+  T data_r{is_root ? data : T{}};
+  inter_comm.bcast(root_rank, data_r);
+  T data_r_2{is_root ? data : T{}};
+  auto r{inter_comm.ibcast(root_rank, data_r_2)};
+  r.wait();
+  return data_r == expected and data_r_2 == expected;
+}
+
+
+BOOST_AUTO_TEST_CASE(inter_communicator_bcast) {
+  BOOST_TEST(inter_communicator_bcast_test(std::vector<int>{1, 2, 3}));
+  BOOST_TEST(inter_communicator_bcast_test(std::vector<double>(100000, 1.5)));
+  BOOST_TEST(inter_communicator_bcast_test(std::list<int>{1, 2, 3}));
+  BOOST_TEST(inter_communicator_bcast_test(std::list<double>(100000, 1.5)));
+}
+
+
+// test broadcast of serialized objects via an inter-communicator, process 0 of the group of
+// processes with even rank in comm_world is the root
+template<typename T>
+bool inter_communicator_serialized_bcast_test(const T &data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  const int my_group{comm_world.rank() % 2};
+  mpl::communicator local_communicator{mpl::communicator::split, comm_world, my_group};
+  mpl::inter_communicator inter_comm{local_communicator, 0, comm_world, my_group == 0 ? 1 : 0};
+  const bool is_root{my_group == 0 and inter_comm.rank() == 0};
+  const int root_rank{my_group == 0 ? (is_root ? mpl::root : mpl::proc_null) : 0};
+  // processes of the root group, which do not provide the data, receive nothing
+  const T expected{my_group == 0 and not is_root ? T{} : data};
+  T data_r{is_root ? data : T{}};
+  inter_comm.bcast(root_rank, data_r);
+  return data_r == expected;
+}
+
+
+BOOST_AUTO_TEST_CASE(inter_communicator_serialized_bcast) {
+  BOOST_TEST(inter_communicator_serialized_bcast_test(
+      std::vector<std::string>{"alpha", "beta", "gamma"}));
+}
+
+
+// test all-reduce via an inter-communicator, each group receives the reduction of the data
+// of the remote group
+bool inter_communicator_allreduce_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  const int my_group{comm_world.rank() % 2};
+  mpl::communicator local_communicator{mpl::communicator::split, comm_world, my_group};
+  mpl::inter_communicator inter_comm{local_communicator, 0, comm_world, my_group == 0 ? 1 : 0};
+  const int n{1000};
+  const std::vector<double> data(n, my_group + 1.0);
+  std::vector<double> data_r(n, 0.0);
+  inter_comm.allreduce(mpl::plus<double>(), data.data(), data_r.data(),
+                       mpl::contiguous_layout<double>(n));
+  const double expected{inter_comm.remote_size() * (2.0 - my_group)};
+  return data_r == std::vector<double>(n, expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(inter_communicator_allreduce) {
+  BOOST_TEST(inter_communicator_allreduce_test());
+}
@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE layout_cache
+
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+#include <mpl/mpl.hpp>
+
+
+bool layout_cache_hit_test() {
+  mpl::environment::enable_layout_cache();
+  const auto stats_0{mpl::environment::layout_cache_stats()};
+  const mpl::vector_layout<double> l_1(100);
+  const mpl::vector_layout<double> l_2(100);
+  const mpl::vector_layout<int> l_3(100);
+  const mpl::strided_vector_layout<double> l_4(10, 2, 4);
+  const mpl::strided_vector_layout<double> l_5(10, 2, 4);
+  const auto stats_1{mpl::environment::layout_cache_stats()};
+  mpl::environment::disable_layout_cache();
+  return l_1.native_handle() == l_2.native_handle() and
+         l_1.native_handle() != l_3.native_handle() and
+         l_4.native_handle() == l_5.native_handle() and stats_1.hits == stats_0.hits + 2 and
+         stats_1.misses == stats_0.misses + 3 and stats_1.live_types == 3 and
+         mpl::environment::layout_cache_stats().live_types == 0;
+}
+
+
+bool layout_cache_capacity_test() {
+  mpl::environment::enable_layout_cache(2);
+  const auto stats_0{mpl::environment::layout_cache_stats()};
+  const mpl::vector_layout<double> l_1(1);
+  const mpl::vector_layout<double> l_2(2);
+  const mpl::vector_layout<double> l_3(3);
+  const auto stats_1{mpl::environment::layout_cache_stats()};
+  // the least recently used data type has been dropped from the cache but is still valid
+  const mpl::vector_layout<double> l_4(1);
+  const bool result{stats_1.live_types == 2 and stats_1.evictions == stats_0.evictions + 1 and
+                    l_1.native_handle() != l_4.native_handle() and l_1.extent() == 1 and
+                    l_4.extent() == 1};
+  mpl::environment::disable_layout_cache();
+  return result;
+}
+
+
+bool layout_cache_send_recv_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  mpl::environment::enable_layout_cache();
+  const int n{16};
+  std::vector<int> data(2 * n), data_r(2 * n, 0), expected(2 * n, 0);
+  for (int i{0}; i < 2 * n; ++i) {
+    data[i] = i;
+    if (i % 2 == 0)
+      expected[i] = i;
+  }
+  bool result{true};
+  for (int k{0}; k < 4; ++k) {
+    const mpl::strided_vector_layout<int> l(n, 1, 2);
+    const mpl::subarray_layout<int> sub(mpl::subarray_layout<int>::parameter{{2 * n, n, 0}});
+    mpl::layouts<int> ls;
+    ls.push_back(l);
+    std::fill(data_r.begin(), data_r.end(), 0);
+    comm_world.sendrecv(data.data(), l, comm_world.rank(), mpl::tag_t{0}, data_r.data(), l,
+                        comm_world.rank(), mpl::tag_t{0});
+    result = result and data_r == expected and ls[0].native_handle() == l.native_handle() and
+             sub.extent() == 2 * n;
+  }
+  const auto stats{mpl::environment::layout_cache_stats()};
+  mpl::environment::disable_layout_cache();
+  return result and stats.hits >= 6;
+}
+
+
+BOOST_AUTO_TEST_CASE(layout_cache) {
+  BOOST_TEST(layout_cache_hit_test());
+  BOOST_TEST(layout_cache_capacity_test());
+  BOOST_TEST(layout_cache_send_recv_test());
+}
+
+
+bool layout_copy_test() {
+  mpl::indexed_layout<double> l_1({{1, 0}, {2, 4}});
+  const mpl::layouts<double> ls(8, l_1);
+  mpl::indexed_layout<double> l_2(l_1);
+  l_1 = mpl::indexed_layout<double>();
+  bool result{l_2.extent() == 6};
+  for (const auto &l : ls)
+    result = result and l.native_handle() == l_2.native_handle();
+  l_2.resize(0, 8);
+  return result and l_2.extent() == 8 and ls[0].extent() == 6 and
+         ls[0].native_handle() != l_2.native_handle();
+}
+
+
+BOOST_AUTO_TEST_CASE(layout_copy) {
+  BOOST_TEST(layout_copy_test());
+}
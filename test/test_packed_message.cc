@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE packed_message
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <string>
+#include <vector>
+
+
+bool pack_unpack_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  mpl::packed_message message(comm_world);
+  const std::vector<double> v{1.0, 2.0, 3.0};
+  const int a[3]{4, 5, 6};
+  message << 1 << v << std::string("abc");
+  message.pack(a, 3);
+  int x{0};
+  std::vector<double> v_r;
+  std::string s_r;
+  int a_r[3]{};
+  message >> x >> v_r >> s_r;
+  message.unpack(a_r, 3);
+  if (x != 1 or v_r != v or s_r != "abc" or a_r[0] != 4 or a_r[2] != 6 or
+      message.remaining() != 0)
+    return false;
+  // clearing the message retains the buffer
+  const int capacity{message.capacity()};
+  message.clear();
+  message << 2.0;
+  return message.size() > 0 and message.capacity() == capacity;
+}
+
+
+bool send_recv_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  mpl::packed_message message(comm_world);
+  if (comm_world.rank() == 0) {
+    for (int i{0}; i < 3; ++i) {
+      message.clear();
+      message << i << std::vector<double>(i, 0.5) << std::string(i, 'x');
+      comm_world.send(message, 1);
+    }
+  }
+  if (comm_world.rank() == 1) {
+    for (int i{0}; i < 3; ++i) {
+      comm_world.recv(message, 0);
+      int x{-1};
+      std::vector<double> v;
+      std::string s;
+      message >> x >> v >> s;
+      if (x != i or v != std::vector<double>(i, 0.5) or s != std::string(i, 'x'))
+        return false;
+    }
+  }
+  return true;
+}
+
+
+bool isend_recv_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  mpl::packed_message message(comm_world);
+  if (comm_world.rank() == 0) {
+    message << 42 << std::vector<int>{1, 2, 3};
+    auto r{comm_world.isend(message, 1)};
+    r.wait();
+  }
+  if (comm_world.rank() == 1) {
+    comm_world.recv(message, 0);
+    int x{0};
+    std::vector<int> v;
+    message >> x >> v;
+    return x == 42 and v == std::vector<int>{1, 2, 3};
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(packed_message) {
+  BOOST_TEST(pack_unpack_test());
+  BOOST_TEST(send_recv_test());
+  BOOST_TEST(isend_recv_test());
+}
@@ -0,0 +1,189 @@
+#define BOOST_TEST_MODULE serialization
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+// class with a heap-allocated member, which is transferred via a user-provided serialization
+class particles {
+  std::string name_;
+  std::unique_ptr<std::vector<double>> positions_{std::make_unique<std::vector<double>>()};
+
+public:
+  particles() = default;
+
+  particles(std::string name, std::vector<double> positions)
+      : name_{std::move(name)},
+        positions_{std::make_unique<std::vector<double>>(std::move(positions))} {
+  }
+
+  particles(const particles &other)
+      : name_{other.name_},
+        positions_{std::make_unique<std::vector<double>>(*other.positions_)} {
+  }
+
+  particles &operator=(const particles &other) {
+    name_ = other.name_;
+    *positions_ = *other.positions_;
+    return *this;
+  }
+
+  friend bool operator==(const particles &a, const particles &b) {
+    return a.name_ == b.name_ and *a.positions_ == *b.positions_;
+  }
+
+  friend struct mpl::serialization<particles>;
+};
+
+
+template<>
+struct mpl::serialization<particles> {
+  static void serialize(mpl::output_archive &ar, const particles &x) {
+    ar << x.name_ << *x.positions_;
+  }
+
+  static void deserialize(mpl::input_archive &ar, particles &x) {
+    ar >> x.name_ >> *x.positions_;
+  }
+};
+
+
+static_assert(mpl::detail::requires_serialization_v<std::vector<std::string>>);
+static_assert(mpl::detail::requires_serialization_v<std::map<std::string, int>>);
+static_assert(mpl::detail::requires_serialization_v<particles>);
+static_assert(not mpl::detail::requires_serialization_v<std::vector<double>>);
+static_assert(not mpl::detail::requires_serialization_v<std::map<int, double>>);
+static_assert(not mpl::detail::requires_serialization_v<std::string>);
+
+
+template<typename T>
+bool archive_test(const T &data) {
+  std::vector<std::byte> buffer;
+  mpl::output_archive oa(buffer);
+  oa << data << 42;
+  T new_data;
+  int x{0};
+  mpl::input_archive ia(oa.data(), oa.size());
+  ia >> new_data >> x;
+  return new_data == data and x == 42 and ia.remaining() == 0;
+}
+
+
+template<typename T>
+bool send_recv_test(const T &data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0)
+    comm_world.send(data, 1);
+  if (comm_world.rank() == 1) {
+    T data_r;
+    comm_world.recv(data_r, 0);
+    return data_r == data;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool isend_irecv_test(const T &data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0) {
+    auto r{comm_world.isend(data, 1)};
+    r.wait();
+  }
+  if (comm_world.rank() == 1) {
+    T data_r;
+    auto r{comm_world.irecv(data_r, 0)};
+    r.wait();
+    return data_r == data;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool bcast_test(const T &data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  for (int root{0}; root < comm_world.size(); ++root) {
+    T data_r{comm_world.rank() == root ? data : T{}};
+    comm_world.bcast(root, data_r);
+    if (not(data_r == data))
+      return false;
+  }
+  return true;
+}
+
+
+bool gatherv_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const auto data{[](int rank) {
+    std::map<std::string, std::vector<int>> m;
+    for (int i{0}; i < rank; ++i)
+      m[std::to_string(i)] = std::vector<int>(i, rank);
+    return m;
+  }};
+  for (int root{0}; root < comm_world.size(); ++root) {
+    std::vector<std::map<std::string, std::vector<int>>> data_r;
+    comm_world.gatherv(root, data(comm_world.rank()), data_r);
+    if (comm_world.rank() == root) {
+      if (static_cast<int>(data_r.size()) != comm_world.size())
+        return false;
+      for (int i{0}; i < comm_world.size(); ++i)
+        if (data_r[i] != data(i))
+          return false;
+    }
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_archive) {
+  BOOST_TEST(archive_test(std::vector<std::string>{"alpha", "", "gamma"}));
+  BOOST_TEST(archive_test(std::vector<std::vector<int>>{{1, 2, 3}, {}, {4}}));
+  BOOST_TEST(archive_test(std::map<std::string, std::vector<double>>{{"x", {1.0, 2.0}}}));
+  BOOST_TEST(archive_test(std::list<std::pair<int, std::string>>{{1, "one"}, {2, "two"}}));
+  BOOST_TEST(archive_test(std::set<std::string>{"a", "b"}));
+  BOOST_TEST(archive_test(std::tuple<int, std::string, std::optional<std::string>>{
+      1, "abc", std::nullopt}));
+  BOOST_TEST(archive_test(particles{"electrons", {1.0, 2.0, 3.0}}));
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_send_recv) {
+  BOOST_TEST(send_recv_test(std::vector<std::string>{"alpha", "", "gamma"}));
+  BOOST_TEST(send_recv_test(std::vector<std::vector<int>>{{1, 2, 3}, {}, {4}}));
+  BOOST_TEST(send_recv_test(std::map<std::string, std::vector<double>>{{"x", {1.0, 2.0}}}));
+  BOOST_TEST(send_recv_test(particles{"electrons", {1.0, 2.0, 3.0}}));
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_isend_irecv) {
+  BOOST_TEST(isend_irecv_test(std::vector<std::string>{"alpha", "", "gamma"}));
+  BOOST_TEST(isend_irecv_test(std::vector<std::vector<int>>{{1, 2, 3}, {}, {4}}));
+  BOOST_TEST(isend_irecv_test(std::map<std::string, std::vector<double>>{{"x", {1.0, 2.0}}}));
+  BOOST_TEST(isend_irecv_test(particles{"electrons", {1.0, 2.0, 3.0}}));
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_bcast) {
+  BOOST_TEST(bcast_test(std::vector<std::string>{"alpha", "", "gamma"}));
+  BOOST_TEST(bcast_test(std::map<std::string, std::vector<double>>{{"x", {1.0, 2.0}}}));
+  BOOST_TEST(bcast_test(particles{"electrons", {1.0, 2.0, 3.0}}));
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_gatherv) {
+  BOOST_TEST(gatherv_test());
+}
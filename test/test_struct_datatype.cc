@@ -0,0 +1,163 @@
+#define BOOST_TEST_MODULE struct_datatype
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <utility>
+#include <vector>
+
+
+struct particle {
+  double x{0}, y{0}, z{0};
+  int id{0};
+  int charge{0};
+};
+
+inline bool operator==(const particle &a, const particle &b) {
+  return a.x == b.x and a.y == b.y and a.z == b.z and a.id == b.id and a.charge == b.charge;
+}
+
+MPL_REFLECTION(particle, x, y, z, id, charge)
+
+// particles are transferred as blocks of bytes
+template<>
+struct mpl::struct_traits<particle> {
+  static constexpr bool is_bytewise_transferable = true;
+};
+
+
+// same layout as particle but without opting in to the transfer as blocks of bytes
+struct vertex {
+  double x{0}, y{0}, z{0};
+  int id{0};
+  int flags{0};
+};
+
+inline bool operator==(const vertex &a, const vertex &b) {
+  return a.x == b.x and a.y == b.y and a.z == b.z and a.id == b.id and a.flags == b.flags;
+}
+
+MPL_REFLECTION(vertex, x, y, z, id, flags)
+
+
+// has padding between its members
+struct padded {
+  char c{0};
+  double d{0};
+};
+
+inline bool operator==(const padded &a, const padded &b) {
+  return a.c == b.c and a.d == b.d;
+}
+
+MPL_REFLECTION(padded, c, d)
+
+
+// not all members are exposed to MPL
+struct partial {
+  int a{0};
+  int b{0};
+};
+
+MPL_REFLECTION(partial, a)
+
+
+// members of the same type with constant stride, not all members are exposed to MPL
+struct strided {
+  double x{0}, u{0}, y{0}, v{0}, z{0};
+};
+
+inline bool operator==(const strided &a, const strided &b) {
+  return a.x == b.x and a.y == b.y and a.z == b.z;
+}
+
+MPL_REFLECTION(strided, z, y, x)
+
+
+// adjacent members of the same type following a member of a different type
+struct mixed {
+  char c{0};
+  double x{0}, y{0}, z{0};
+};
+
+inline bool operator==(const mixed &a, const mixed &b) {
+  return a.c == b.c and a.x == b.x and a.y == b.y and a.z == b.z;
+}
+
+MPL_REFLECTION(mixed, c, x, y, z)
+
+
+template<typename T>
+int combiner() {
+  int num_integers, num_addresses, num_datatypes, combiner;
+  MPI_Type_get_envelope(mpl::detail::datatype_traits<T>::get_datatype(), &num_integers,
+                        &num_addresses, &num_datatypes, &combiner);
+  return combiner;
+}
+
+
+// combiner and number of blocks of the data type that has been resized to the size of T
+template<typename T>
+std::pair<int, int> inner_combiner() {
+  MPI_Aint addresses[2];
+  MPI_Datatype inner;
+  MPI_Type_get_contents(mpl::detail::datatype_traits<T>::get_datatype(), 0, 2, 1, nullptr,
+                        addresses, &inner);
+  int num_integers, num_addresses, num_datatypes, combiner;
+  MPI_Type_get_envelope(inner, &num_integers, &num_addresses, &num_datatypes, &combiner);
+  std::vector<int> integers(num_integers);
+  std::vector<MPI_Aint> inner_addresses(num_addresses);
+  std::vector<MPI_Datatype> datatypes(num_datatypes);
+  MPI_Type_get_contents(inner, num_integers, num_addresses, num_datatypes, integers.data(),
+                        inner_addresses.data(), datatypes.data());
+  MPI_Type_free(&inner);
+  const int count{combiner == MPI_COMBINER_CONTIGUOUS ? 1 : integers[0]};
+  return {combiner, count};
+}
+
+
+template<typename T>
+bool send_recv_test(const std::vector<T> &data) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0)
+    comm_world.send(data.begin(), data.end(), 1);
+  if (comm_world.rank() == 1) {
+    std::vector<T> data_r(data.size());
+    comm_world.recv(data_r.begin(), data_r.end(), 0);
+    return data_r == data;
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(struct_datatype_contiguous_bytes) {
+  // initializes MPI
+  [[maybe_unused]] const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  BOOST_TEST(combiner<particle>() == MPI_COMBINER_CONTIGUOUS);
+  BOOST_TEST(combiner<padded>() != MPI_COMBINER_CONTIGUOUS);
+  BOOST_TEST(combiner<partial>() != MPI_COMBINER_CONTIGUOUS);
+  BOOST_TEST(combiner<vertex>() != MPI_COMBINER_CONTIGUOUS);
+  mpl::contiguous_layout<particle> l(8);
+  BOOST_TEST(l.byte_extent() == static_cast<mpl::ssize_t>(8 * sizeof(particle)));
+}
+
+
+BOOST_AUTO_TEST_CASE(struct_datatype_coalescing) {
+  // initializes MPI
+  [[maybe_unused]] const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  BOOST_TEST((inner_combiner<partial>() == std::pair<int, int>{MPI_COMBINER_CONTIGUOUS, 1}));
+  BOOST_TEST((inner_combiner<strided>() == std::pair<int, int>{MPI_COMBINER_HVECTOR, 3}));
+  BOOST_TEST((inner_combiner<padded>() == std::pair<int, int>{MPI_COMBINER_STRUCT, 2}));
+  BOOST_TEST((inner_combiner<mixed>() == std::pair<int, int>{MPI_COMBINER_STRUCT, 2}));
+  BOOST_TEST((inner_combiner<vertex>() == std::pair<int, int>{MPI_COMBINER_STRUCT, 2}));
+}
+
+
+BOOST_AUTO_TEST_CASE(struct_datatype_send_recv) {
+  BOOST_TEST(send_recv_test(std::vector<particle>{{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}}));
+  BOOST_TEST(send_recv_test(std::vector<padded>{{'a', 1}, {'b', 2}}));
+  BOOST_TEST(send_recv_test(std::vector<vertex>{{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}}));
+  BOOST_TEST(send_recv_test(std::vector<strided>{{1, 0, 2, 0, 3}, {4, 0, 5, 0, 6}}));
+  BOOST_TEST(send_recv_test(std::vector<mixed>{{'a', 1, 2, 3}, {'b', 4, 5, 6}}));
+}
@@ -0,0 +1,195 @@
+#define BOOST_TEST_MODULE tuned_communicator
+
+#include <boost/test/included/unit_test.hpp>
+#include <mpl/mpl.hpp>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+#include "test_helper.hpp"
+
+
+// associative but non-commutative reduction operation, yields the first operand
+template<typename T>
+class first {
+public:
+  T operator()(const T &a, const T &) const {
+    return a;
+  }
+};
+
+
+template<typename T>
+bool allreduce_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const mpl::tuned_communicator comm{comm_world};
+  for (const auto a : {mpl::allreduce_algorithm::native,
+                       mpl::allreduce_algorithm::recursive_doubling,
+                       mpl::allreduce_algorithm::ring, mpl::allreduce_algorithm::rabenseifner})
+    for (const int n : {0, 1, 3, 1000}) {
+      std::vector<T> send_data(n);
+      std::iota(begin(send_data), end(send_data), val);
+      for (int i{0}; i < comm.rank(); ++i)
+        for (auto &x : send_data)
+          ++x;
+      std::vector<T> expected(n, T{});
+      for (int r{0}; r < comm.size(); ++r)
+        for (int j{0}; j < n; ++j) {
+          T x{val};
+          for (int i{0}; i < j + r; ++i)
+            ++x;
+          expected[j] = expected[j] + x;
+        }
+      std::vector<T> recv_data(n);
+      const mpl::contiguous_layout<T> l(n);
+      comm.allreduce(a, add<T>(), send_data.data(), recv_data.data(), l);
+      if (recv_data != expected)
+        return false;
+      // first element is contributed by the process with rank 0
+      std::vector<T> first_data(n);
+      std::iota(begin(first_data), end(first_data), val);
+      comm.allreduce(a, first<T>(), send_data.data(), recv_data.data(), l);
+      if (recv_data != first_data)
+        return false;
+    }
+  return true;
+}
+
+
+bool allreduce_commutative_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const mpl::tuned_communicator comm{comm_world};
+  const int n{12345};
+  std::vector<int> send_data(n);
+  std::iota(begin(send_data), end(send_data), comm.rank());
+  std::vector<int> expected(n);
+  for (int j{0}; j < n; ++j)
+    expected[j] = comm.size() * j + comm.size() * (comm.size() - 1) / 2;
+  for (const auto a : {mpl::allreduce_algorithm::ring, mpl::allreduce_algorithm::rabenseifner}) {
+    std::vector<int> recv_data(n);
+    comm.allreduce(a, mpl::plus<int>(), send_data.data(), recv_data.data(),
+                   mpl::contiguous_layout<int>(n));
+    if (recv_data != expected)
+      return false;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool bcast_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  mpl::tuned_communicator comm{comm_world};
+  comm.segment_size(100 * sizeof(T));
+  for (const auto a : {mpl::bcast_algorithm::native, mpl::bcast_algorithm::binomial,
+                       mpl::bcast_algorithm::pipelined_chain})
+    for (int root{0}; root < comm.size(); ++root)
+      for (const int n : {0, 1, 1000}) {
+        std::vector<T> expected(n);
+        std::iota(begin(expected), end(expected), val);
+        std::vector<T> data(comm.rank() == root ? expected : std::vector<T>(n));
+        comm.bcast(a, root, data.data(), mpl::contiguous_layout<T>(n));
+        if (data != expected)
+          return false;
+      }
+  return true;
+}
+
+
+template<typename T>
+bool alltoallv_test(const T &val) {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  const mpl::tuned_communicator comm{comm_world};
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  // process i sends i + j + 1 elements to process j, received blocks are stored in reverse
+  // order
+  const auto block{[&val](int source, int dest) {
+    std::vector<T> data(source + dest + 1);
+    std::iota(begin(data), end(data), val);
+    for (auto &x : data)
+      for (int i{0}; i < 10 * source + dest; ++i)
+        ++x;
+    return data;
+  }};
+  std::vector<T> send_data;
+  mpl::contiguous_layouts<T> sendls;
+  mpl::displacements senddispls;
+  for (int j{0}; j < size; ++j) {
+    senddispls.push_back(sizeof(T) * send_data.size());
+    const auto b{block(rank, j)};
+    sendls.push_back(mpl::contiguous_layout<T>(b.size()));
+    send_data.insert(end(send_data), begin(b), end(b));
+  }
+  std::vector<T> expected;
+  mpl::contiguous_layouts<T> recvls;
+  mpl::displacements recvdispls(size);
+  for (int j{size - 1}; j >= 0; --j) {
+    recvdispls[j] = sizeof(T) * expected.size();
+    const auto b{block(j, rank)};
+    expected.insert(end(expected), begin(b), end(b));
+  }
+  for (int j{0}; j < size; ++j)
+    recvls.push_back(mpl::contiguous_layout<T>(rank + j + 1));
+  for (const auto a : {mpl::alltoallv_algorithm::native, mpl::alltoallv_algorithm::pairwise,
+                       mpl::alltoallv_algorithm::bruck}) {
+    std::vector<T> recv_data(expected.size());
+    comm.alltoallv(a, send_data.data(), sendls, senddispls, recv_data.data(), recvls,
+                   recvdispls);
+    if (recv_data != expected)
+      return false;
+  }
+  return true;
+}
+
+
+bool autotune_test() {
+  const mpl::communicator &comm_world{mpl::environment::comm_world()};
+  mpl::tuned_communicator comm{comm_world};
+  comm.autotune(1024, 1);
+  const char *const filename{"test_tuned_communicator.txt"};
+  if (not comm.save(filename))
+    return false;
+  mpl::tuned_communicator other_comm{comm_world};
+  if (not other_comm.load(filename))
+    return false;
+  for (std::size_t bytes{1}; bytes <= 4096; bytes *= 2)
+    if (comm.selection().allreduce(bytes) != other_comm.selection().allreduce(bytes) or
+        comm.selection().bcast(bytes) != other_comm.selection().bcast(bytes) or
+        comm.selection().alltoallv(bytes) != other_comm.selection().alltoallv(bytes))
+      return false;
+  // operations with the tuned selection of algorithms
+  std::vector<double> data(300, comm.rank());
+  std::vector<double> sum(300);
+  comm.allreduce(mpl::plus<double>(), data.data(), sum.data(),
+                 mpl::contiguous_layout<double>(data.size()));
+  if (sum != std::vector<double>(300, comm.size() * (comm.size() - 1) / 2))
+    return false;
+  comm_world.barrier();
+  if (comm.rank() == 0)
+    std::remove(filename);
+  return not other_comm.load(filename);
+}
+
+
+BOOST_AUTO_TEST_CASE(tuned_communicator_allreduce) {
+  BOOST_TEST(allreduce_test(1.0));
+  BOOST_TEST(allreduce_test(tuple{1, 2.0}));
+  BOOST_TEST(allreduce_commutative_test());
+}
+
+
+BOOST_AUTO_TEST_CASE(tuned_communicator_bcast) {
+  BOOST_TEST(bcast_test(1.0));
+  BOOST_TEST(bcast_test(tuple{1, 2.0}));
+}
+
+
+BOOST_AUTO_TEST_CASE(tuned_communicator_alltoallv) {
+  BOOST_TEST(alltoallv_test(1.0));
+  BOOST_TEST(alltoallv_test(tuple{1, 2.0}));
+}
+
+
+BOOST_AUTO_TEST_CASE(tuned_communicator_autotune) {
+  BOOST_TEST(autotune_test());
+}